@@ -0,0 +1,110 @@
+#!/usr/bin/env bash
+# Replication load test: one dedicated server and N headless bot clients on this machine over loopback.
+#
+# Build the AuraServer and Aura (Game) targets for Linux in Development first, then:
+#   Scripts/LoadTest/run_loadtest.sh --clients 16 --duration 120 [--lag 50] [--loss 1] [--map /Game/Maps/StartupMap]
+#
+# Results are collected in Saved/LoadTest/<timestamp>/:
+#   AuraLoadTest_*.csv  bytes/s, packets/s, loss and lag per connection, plus server game thread time (one row per second)
+#   Profiling/          csv profiler capture with ReplicationGraph per-class time and bytes
+#   server.utrace       Networking Insights trace with per-class and per-property bytes
+#   server.log, client_N.log
+
+set -euo pipefail
+
+PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+BIN_DIR="$PROJECT_DIR/Binaries/Linux"
+
+CLIENTS=8
+DURATION=120
+MAP=/Game/Maps/StartupMap
+PORT=7777
+LAG=0
+LOSS=0
+SERVER_BIN="$BIN_DIR/AuraServer"
+CLIENT_BIN="$BIN_DIR/Aura"
+
+usage()
+{
+	echo "Usage: $0 [--clients N] [--duration SECONDS] [--map MAP] [--port PORT] [--lag MS] [--loss PERCENT] [--server-bin PATH] [--client-bin PATH]"
+	exit 1
+}
+
+while [[ $# -gt 0 ]]; do
+	case "$1" in
+		--clients) CLIENTS="$2"; shift 2 ;;
+		--duration) DURATION="$2"; shift 2 ;;
+		--map) MAP="$2"; shift 2 ;;
+		--port) PORT="$2"; shift 2 ;;
+		--lag) LAG="$2"; shift 2 ;;
+		--loss) LOSS="$2"; shift 2 ;;
+		--server-bin) SERVER_BIN="$2"; shift 2 ;;
+		--client-bin) CLIENT_BIN="$2"; shift 2 ;;
+		*) usage ;;
+	esac
+done
+
+for BIN in "$SERVER_BIN" "$CLIENT_BIN"; do
+	if [[ ! -x "$BIN" ]]; then
+		echo "Missing binary: $BIN (build the AuraServer and Aura targets for Linux first)"
+		exit 1
+	fi
+done
+
+OUT_DIR="$PROJECT_DIR/Saved/LoadTest/$(date +%Y%m%d_%H%M%S)"
+mkdir -p "$OUT_DIR"
+# Only files written after this marker belong to this run.
+touch "$OUT_DIR/.start"
+
+# Packet emulation is applied on both ends so the lag and loss apply in both directions.
+NET_EMULATION=""
+if [[ "$LAG" != "0" || "$LOSS" != "0" ]]; then
+	NET_EMULATION="-PktLag=$LAG -PktLoss=$LOSS"
+fi
+
+# Server frames to capture with the csv profiler (the server ticks at 30 Hz by default).
+CSV_FRAMES=$((DURATION * 30))
+
+CLIENT_PIDS=()
+cleanup()
+{
+	for PID in ${CLIENT_PIDS[@]+"${CLIENT_PIDS[@]}"}; do
+		kill "$PID" 2>/dev/null || true
+	done
+}
+trap cleanup EXIT
+
+echo "Starting server on port $PORT ($CLIENTS clients, ${DURATION}s, lag ${LAG}ms, loss ${LOSS}%)"
+"$SERVER_BIN" "$MAP" -server -log -unattended -port="$PORT" \
+	-AuraLoadTest -AuraLoadTestDuration="$DURATION" \
+	-csvCaptureFrames="$CSV_FRAMES" \
+	-trace=net,cpu,frame -NetTrace=1 -tracefile="$OUT_DIR/server.utrace" \
+	$NET_EMULATION \
+	> "$OUT_DIR/server.log" 2>&1 &
+SERVER_PID=$!
+
+# Give the server time to load the map before clients connect.
+sleep 10
+
+for ((i = 0; i < CLIENTS; i++)); do
+	"$CLIENT_BIN" "127.0.0.1:$PORT" -game -nullrhi -nosound -unattended -log \
+		-AuraBot -ResX=640 -ResY=480 -windowed \
+		$NET_EMULATION \
+		> "$OUT_DIR/client_$i.log" 2>&1 &
+	CLIENT_PIDS+=($!)
+	# Stagger the joins so the login burst does not dominate the first samples.
+	sleep 1
+done
+
+# The server exits on its own after -AuraLoadTestDuration.
+wait "$SERVER_PID" || true
+cleanup
+
+PROFILING_DIR="$PROJECT_DIR/Saved/Profiling"
+if [[ -d "$PROFILING_DIR" ]]; then
+	mkdir -p "$OUT_DIR/Profiling"
+	find "$PROFILING_DIR/AuraLoadTest" -name '*.csv' -newer "$OUT_DIR/.start" -exec cp {} "$OUT_DIR"/ \; 2>/dev/null || true
+	find "$PROFILING_DIR/CSV" -name '*.csv*' -newer "$OUT_DIR/.start" -exec cp {} "$OUT_DIR/Profiling"/ \; 2>/dev/null || true
+fi
+
+echo "Results in $OUT_DIR"
@@ -10,6 +10,11 @@ public class AuraTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V4;
 
+		// Push model replication (UAuraAttributeSet, AAuraPlayerState) is compiled in by the engine's
+		// default for Server and Editor targets and enabled at runtime by net.IsPushModelEnabled.
+		// Forcing bWithPushModel needs a unique build environment, i.e. a source-built engine.
+		// Without it, game builds hosting a listen server fall back to comparing properties.
+
 		ExtraModuleNames.AddRange( new string[] { "Aura" } );
 	}
 }
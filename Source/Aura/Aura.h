@@ -4,4 +4,7 @@
 
 #include "CoreMinimal.h"
 
-#define CUSTOM_DEPTH_RED 250
\ No newline at end of file
+#define CUSTOM_DEPTH_RED 250
+
+// stat Aura で計測値を確認する
+DECLARE_STATS_GROUP(TEXT("Aura"), STATGROUP_Aura, STATCAT_Advanced);
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "AbilitySystem/AbilityTasks/TargetDataUnderMouse.h"
 #include "AbilitySystemComponent.h"
+#include "Player/AuraPlayerController.h"
 
 UTargetDataUnderMouse* UTargetDataUnderMouse::CreateTargetDataUnderMouse(UGameplayAbility* OwningAbility)
 {
@@ -53,7 +54,13 @@ void UTargetDataUnderMouse::SendMouseCursorData()
 	// HitResultの取得
 	APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
 	FHitResult CursorHit;
-	PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+
+	// ロードテスト用ボットはカーソルを持たないので、ボットの狙いを使う
+	const AAuraPlayerController* AuraPC = Cast<AAuraPlayerController>(PC);
+	if (!AuraPC || !AuraPC->GetBotTargetHit(CursorHit))
+	{
+		PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+	}
 
 	// TargetDataにHitResultを設定
 	Data->HitResult = CursorHit;
@@ -4,14 +4,82 @@
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AuraGameplayTags.h"
 #include "AbilitySystem/Abilities/AuraGameplayAbility.h"
+#include "AbilitySystem/Data/AuraAbilitySet.h"
+#include "AbilitySystem/AuraTagReplicationProfiler.h"
+#include "Aura/Aura.h"
+#include "GameplayTagsManager.h"
+#include "TimerManager.h"
+#include "Engine/NetConnection.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("Add Character Abilities"), STAT_AuraAddCharacterAbilities, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("Give Ability Set"), STAT_AuraGiveAbilitySet, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("ASC Ability Input Pressed"), STAT_AuraASCAbilityInputPressed, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("ASC Ability Input Held"), STAT_AuraASCAbilityInputHeld, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("ASC Ability Input Released"), STAT_AuraASCAbilityInputReleased, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Activation RPCs Received"), STAT_AuraActivationRPCsReceived, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Activation RPCs Duplicate"), STAT_AuraActivationRPCsDuplicate, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Activation RPCs Rejected"), STAT_AuraActivationRPCsRejected, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Message Tags Sent"), STAT_AuraMessageTagsSent, STATGROUP_Aura);
+
+static FAutoConsoleCommandWithWorld CVarDumpActivationRPCStats(
+	TEXT("Aura.DumpActivationRPCStats"),
+	TEXT("Logs received / duplicate / rejected ability activation RPCs per connection (server only)."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client) return;
+
+		for (TObjectIterator<UAuraAbilitySystemComponent> It; It; ++It)
+		{
+			const UAuraAbilitySystemComponent* ASC = *It;
+			if (ASC->GetWorld() != World) continue;
+
+			const AActor* Owner = ASC->GetOwner();
+			const UNetConnection* Connection = Owner ? Owner->GetNetConnection() : nullptr;
+			if (!Connection) continue;
+
+			const FAuraActivationRPCStats& Stats = ASC->GetActivationRPCStats();
+			UE_LOG(LogTemp, Log, TEXT("[%s] %s: Received %d, Duplicate %d, Rejected %d"),
+				*Connection->LowLevelGetRemoteAddress(true), *GetNameSafe(Owner), Stats.Received, Stats.Duplicate, Stats.Rejected);
+		}
+	})
+);
 
 void UAuraAbilitySystemComponent::AbilityActorInfoSet()
 {
-	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::ClientEffectApplied);
+	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::EffectApplied);
+
+	// 所持タグをネイティブタグのビットセットに反映する（親タグのカウントも変化時に通知される）
+	if (!RegisterGenericGameplayTagEvent().IsBoundToObject(this))
+	{
+		RegisterGenericGameplayTagEvent().AddUObject(this, &UAuraAbilitySystemComponent::OnOwnedTagCountChanged);
+
+		OwnedNativeTagBits = 0;
+		FGameplayTagContainer OwnedTags;
+		GetOwnedGameplayTags(OwnedTags);
+		OwnedNativeTagBits = FAuraGameplayTags::Get().GetMatchBits(OwnedTags);
+	}
+}
+
+void UAuraAbilitySystemComponent::OnOwnedTagCountChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	const EAuraNativeTag* NativeTag = FAuraGameplayTags::Get().FindNativeTag(Tag);
+	if (!NativeTag) return;
+
+	if (NewCount > 0)
+	{
+		OwnedNativeTagBits |= AuraNativeTagBit(*NativeTag);
+	}
+	else
+	{
+		OwnedNativeTagBits &= ~AuraNativeTagBit(*NativeTag);
+	}
 }
 
-void UAuraAbilitySystemComponent::AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>> StartupAbilities)
+void UAuraAbilitySystemComponent::AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>>& StartupAbilities)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AuraAddCharacterAbilities);
+
 	for (TSubclassOf<UGameplayAbility> AbilityClass : StartupAbilities)
 	{
 		FGameplayAbilitySpec AbilitySpec = FGameplayAbilitySpec(AbilityClass, 1);
@@ -22,30 +90,93 @@ void UAuraAbilitySystemComponent::AddCharacterAbilities(const TArray<TSubclassOf
 		}
 		GiveAbility(AbilitySpec);
 		//GiveAbilityAndActivateOnce(AbilitySpec);
+
+#if AURA_TAG_REPLICATION_PROFILER
+		UAuraTagReplicationProfiler::RecordTags(GetOwner(), AbilitySpec.DynamicAbilityTags);
+#endif
 	}
 	
 }
 
-void UAuraAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag& InputTag)
+void UAuraAbilitySystemComponent::GiveAbilitySet(const UAuraAbilitySet* AbilitySet)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraGiveAbilitySet);
+
+	if (!AbilitySet || !IsOwnerActorAuthoritative()) return;
+
+	const TArray<FGameplayAbilitySpec>& SpecTemplates = AbilitySet->GetSpecTemplates();
+	if (SpecTemplates.IsEmpty()) return;
+
+	// テンプレートをコピーし、ハンドルだけ新しくする
+	// 付与はGiveAbilityに任せる（スコープロック中の保留・AbilitySpecDirtiedCallbacks・Specごとのダーティ化を保つ）
+	for (const FGameplayAbilitySpec& SpecTemplate : SpecTemplates)
+	{
+		FGameplayAbilitySpec AbilitySpec = SpecTemplate;
+		AbilitySpec.Handle.GenerateNewHandle();
+		GiveAbility(AbilitySpec);
+
+#if AURA_TAG_REPLICATION_PROFILER
+		UAuraTagReplicationProfiler::RecordTags(GetOwner(), AbilitySpec.DynamicAbilityTags);
+#endif
+	}
+}
+
+void UAuraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AuraASCAbilityInputPressed);
+
 	if (!InputTag.IsValid()) return;
 
 	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
 	{
 		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
 		{
-			AbilitySpecInputReleased(AbilitySpec);
+			// 押下エッジ：状態をリセットし、有効化リクエストを1回だけ送る
+			AbilitySpecInputPressed(AbilitySpec);
+
+			FAuraAbilityInputState& InputState = AbilityInputStates.FindOrAdd(AbilitySpec.Handle);
+			InputState = FAuraAbilityInputState();
+			InputState.Phase = EAuraAbilityInputPhase::Pressed;
 
 			if (!AbilitySpec.IsActive())
 			{
-				TryActivateAbility(AbilitySpec.Handle);
+				TryActivateAbilityFromInput(AbilitySpec, InputState);
+			}
+		}
+	}
+}
+
+void UAuraAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag& InputTag)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraASCAbilityInputHeld);
+
+	if (!InputTag.IsValid()) return;
+
+	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	{
+		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
+		{
+			FAuraAbilityInputState& InputState = AbilityInputStates.FindOrAdd(AbilitySpec.Handle);
+			if (InputState.Phase == EAuraAbilityInputPhase::Released)
+			{
+				// Pressedを経由せずに押しっぱなしが始まった（LMBのターゲット開始など）
+				AbilitySpecInputPressed(AbilitySpec);
 			}
+			InputState.Phase = EAuraAbilityInputPhase::Held;
+
+			// 有効化済み・リクエスト中・再試行待ちの間は何も送らない
+			if (InputState.bActivated || InputState.bActivationRequested || AbilitySpec.IsActive()) continue;
+			if (GetWorld()->GetTimeSeconds() < InputState.NextRetryTime) continue;
+
+			TryActivateAbilityFromInput(AbilitySpec, InputState);
 		}
 	}
 }
 
 void UAuraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& InputTag)
 {
+	SCOPE_CYCLE_COUNTER(STAT_AuraASCAbilityInputReleased);
+
 	if (!InputTag.IsValid()) return;
 
 	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
@@ -53,17 +184,171 @@ void UAuraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
 		{
 			AbilitySpecInputReleased(AbilitySpec);
+			AbilityInputStates.Remove(AbilitySpec.Handle);
 		}
 	}
 }
 
-void UAuraAbilitySystemComponent::ClientEffectApplied_Implementation(UAbilitySystemComponent* AbilitySystemComponent,
+void UAuraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	AbilityGivenDelegate.Broadcast(AbilitySpec);
+}
+
+void UAuraAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
+{
+	Super::NotifyAbilityActivated(Handle, Ability);
+
+	if (FAuraAbilityInputState* InputState = AbilityInputStates.Find(Handle))
+	{
+		InputState->bActivated = true;
+	}
+
+	if (Handle == ServerActivatingHandle)
+	{
+		bServerActivationSucceeded = true;
+	}
+}
+
+void UAuraAbilitySystemComponent::InternalServerTryActivateAbility(FGameplayAbilitySpecHandle AbilityToActivate,
+	bool InputPressed, const FPredictionKey& PredictionKey, const FGameplayEventData* TriggerEventData)
+{
+	const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(AbilityToActivate);
+	const bool bAlreadyActive = AbilitySpec && AbilitySpec->IsActive();
+
+	ServerActivatingHandle = AbilityToActivate;
+	bServerActivationSucceeded = false;
+
+	Super::InternalServerTryActivateAbility(AbilityToActivate, InputPressed, PredictionKey, TriggerEventData);
+
+	ServerActivatingHandle = FGameplayAbilitySpecHandle();
+
+	++ActivationRPCStats.Received;
+	INC_DWORD_STAT(STAT_AuraActivationRPCsReceived);
+
+	if (bAlreadyActive)
+	{
+		// 既に有効なAbilityへの重複リクエスト
+		++ActivationRPCStats.Duplicate;
+		INC_DWORD_STAT(STAT_AuraActivationRPCsDuplicate);
+	}
+	else if (!bServerActivationSucceeded)
+	{
+		++ActivationRPCStats.Rejected;
+		INC_DWORD_STAT(STAT_AuraActivationRPCsRejected);
+	}
+}
+
+void UAuraAbilitySystemComponent::ClientActivateAbilityFailed_Implementation(FGameplayAbilitySpecHandle AbilityToActivate,
+	int16 PredictionKey)
+{
+	Super::ClientActivateAbilityFailed_Implementation(AbilityToActivate, PredictionKey);
+
+	// サーバーに拒否された：押しっぱなしなら間隔を空けて再試行
+	if (FAuraAbilityInputState* InputState = AbilityInputStates.Find(AbilityToActivate))
+	{
+		BackOffActivation(*InputState);
+	}
+}
+
+void UAuraAbilitySystemComponent::TryActivateAbilityFromInput(FGameplayAbilitySpec& AbilitySpec, FAuraAbilityInputState& InputState)
+{
+	InputState.bActivationRequested = true;
+
+	if (!TryActivateAbility(AbilitySpec.Handle))
+	{
+		// ローカルで失敗（クールダウン・コスト等）：RPCは送られていない
+		BackOffActivation(InputState);
+	}
+}
+
+void UAuraAbilitySystemComponent::BackOffActivation(FAuraAbilityInputState& InputState)
+{
+	InputState.bActivationRequested = false;
+	InputState.bActivated = false;
+
+	const float Delay = FMath::Min(ActivationRetryDelay * FMath::Pow(2.f, InputState.FailedAttempts), MaxActivationRetryDelay);
+	InputState.NextRetryTime = GetWorld()->GetTimeSeconds() + Delay;
+	InputState.FailedAttempts = FMath::Min(InputState.FailedAttempts + 1, 16);
+}
+
+void UAuraAbilitySystemComponent::EffectApplied(UAbilitySystemComponent* AbilitySystemComponent,
                                                 const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle)
 {
+	if (!IsOwnerActorAuthoritative()) return;
+
 	FGameplayTagContainer TagContainer;
 	EffectSpec.GetAllAssetTags(TagContainer);
 
-	EffectAssetTags.Broadcast(TagContainer);
+#if AURA_TAG_REPLICATION_PROFILER
+	// 持続型GEのSpecと共に送られる動的タグだけを数える（Minimalでは送られず、Mixedでは所有者にだけ送られる）
+	if (EffectSpec.Def && EffectSpec.Def->DurationPolicy != EGameplayEffectDurationType::Instant && ReplicationMode != EGameplayEffectReplicationMode::Minimal)
+	{
+		if (ReplicationMode == EGameplayEffectReplicationMode::Full)
+		{
+			UAuraTagReplicationProfiler::RecordTagsForAllConnections(GetWorld(), EffectSpec.GetDynamicAssetTags());
+			UAuraTagReplicationProfiler::RecordTagsForAllConnections(GetWorld(), EffectSpec.DynamicGrantedTags);
+		}
+		else
+		{
+			UAuraTagReplicationProfiler::RecordTags(GetOwner(), EffectSpec.GetDynamicAssetTags());
+			UAuraTagReplicationProfiler::RecordTags(GetOwner(), EffectSpec.DynamicGrantedTags);
+		}
+	}
+#endif
+
+	// 通知先のプレイヤーがいない（敵など）場合は送らない
+	if (!AbilityActorInfo.IsValid() || !AbilityActorInfo->PlayerController.IsValid()) return;
+
+	const FGameplayTag& MessageTag = FAuraGameplayTags::Get().Message;
+	const bool bWasEmpty = PendingMessageTagNetIndices.IsEmpty();
+
+	for (const FGameplayTag& Tag : TagContainer)
+	{
+		// Message.* 以外のタグは送らない
+		if (!Tag.MatchesTag(MessageTag)) continue;
+
+		const FGameplayTagNetIndex NetIndex = UGameplayTagsManager::Get().GetNetIndexFromTag(Tag);
+		if (NetIndex != INVALID_TAGNETINDEX)
+		{
+			PendingMessageTagNetIndices.Add(NetIndex);
+		}
+	}
+
+	if (bWasEmpty && !PendingMessageTagNetIndices.IsEmpty())
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UAuraAbilitySystemComponent::FlushPendingMessageTags);
+	}
+}
+
+void UAuraAbilitySystemComponent::FlushPendingMessageTags()
+{
+	if (PendingMessageTagNetIndices.IsEmpty()) return;
+
+	INC_DWORD_STAT_BY(STAT_AuraMessageTagsSent, PendingMessageTagNetIndices.Num());
+	ClientMessageTagsApplied(PendingMessageTagNetIndices);
+
+	PendingMessageTagNetIndices.Reset();
+}
+
+void UAuraAbilitySystemComponent::ClientMessageTagsApplied_Implementation(const TArray<uint16>& MessageTagNetIndices)
+{
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
 
+	// インデックスはクライアントから検証できないので、不正なものは捨て、同じタグは1回にまとめる
+	FGameplayTagContainer TagContainer;
+	for (const uint16 NetIndex : MessageTagNetIndices)
+	{
+		const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(TagsManager.GetTagNameFromNetIndex(NetIndex), false);
+		if (Tag.IsValid())
+		{
+			TagContainer.AddTag(Tag);
+		}
+	}
 
+	if (!TagContainer.IsEmpty())
+	{
+		EffectAssetTags.Broadcast(TagContainer);
+	}
 }
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AbilitySystem/AuraAttributeSnapshotSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectAggregator.h"
+#include "AbilitySystem/Data/AuraCombatData.h"
+#include "Aura/Aura.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attribute Snapshots Applied"), STAT_AuraAttributeSnapshotsApplied, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attribute Snapshots Captured"), STAT_AuraAttributeSnapshotsCaptured, STATGROUP_Aura);
+
+static TAutoConsoleVariable<bool> CVarAuraAttributeSnapshots(
+	TEXT("Aura.AttributeSnapshots"),
+	true,
+	TEXT("Initialize default attributes from cached snapshots instead of applying the instant effects every spawn."));
+
+namespace AuraAttributeSnapshot
+{
+	void CaptureModifiedBaseValues(const TSubclassOf<UGameplayEffect>& EffectClass, const UAbilitySystemComponent* ASC, TArray<TPair<FGameplayAttribute, float>>& OutValues)
+	{
+		if (!EffectClass) return;
+
+		for (const FGameplayModifierInfo& Modifier : EffectClass->GetDefaultObject<UGameplayEffect>()->Modifiers)
+		{
+			if (!Modifier.Attribute.IsValid()) continue;
+			if (OutValues.ContainsByPredicate([&Modifier](const TPair<FGameplayAttribute, float>& Pair) { return Pair.Key == Modifier.Attribute; })) continue;
+
+			OutValues.Emplace(Modifier.Attribute, ASC->GetNumericAttributeBase(Modifier.Attribute));
+		}
+	}
+}
+
+bool UAuraAttributeSnapshotSubsystem::IsEnabled()
+{
+	return CVarAuraAttributeSnapshots.GetValueOnGameThread();
+}
+
+void UAuraAttributeSnapshotSubsystem::CaptureSnapshot(const FAuraAttributeSnapshotKey& Key, const UAbilitySystemComponent* ASC)
+{
+	check(ASC);
+
+	FAuraAttributeSnapshot& Snapshot = Snapshots.FindOrAdd(Key);
+	Snapshot = FAuraAttributeSnapshot();
+
+	// ベイク済みのPrimaryは2つ目のキャッシュを持たずにAuraCombatDataから設定する
+	Snapshot.bPrimaryFromCombatData = FAuraCombatData::Get().FindAttributeDefaults(Key.PrimaryEffect.ResolveObjectPtr(), 1) != nullptr;
+	if (!Snapshot.bPrimaryFromCombatData)
+	{
+		AuraAttributeSnapshot::CaptureModifiedBaseValues(Key.PrimaryEffect.ResolveObjectPtr(), ASC, Snapshot.PrimaryBaseValues);
+	}
+	AuraAttributeSnapshot::CaptureModifiedBaseValues(Key.VitalEffect.ResolveObjectPtr(), ASC, Snapshot.VitalBaseValues);
+
+	INC_DWORD_STAT(STAT_AuraAttributeSnapshotsCaptured);
+}
+
+void UAuraAttributeSnapshotSubsystem::ApplySnapshot(const FAuraAttributeSnapshot& Snapshot, const FAuraAttributeSnapshotKey& Key, UAbilitySystemComponent* ASC, TFunctionRef<void()> ApplySecondaryEffect) const
+{
+	check(ASC);
+
+	{
+		// Secondaryのアグリゲーターの再計算をスコープの終わりで1回にまとめる
+		FScopedAggregatorOnDirtyBatch AggregatorBatch;
+
+		if (Snapshot.bPrimaryFromCombatData)
+		{
+			FAuraCombatData::Get().ApplyAttributeDefaults(Key.PrimaryEffect.ResolveObjectPtr(), 1, ASC);
+		}
+		for (const TPair<FGameplayAttribute, float>& Pair : Snapshot.PrimaryBaseValues)
+		{
+			ASC->SetNumericAttributeBase(Pair.Key, Pair.Value);
+		}
+
+		ApplySecondaryEffect();
+	}
+
+	// HealthやManaはMaxHealth/MaxManaでクランプされるので、Secondaryの計算が終わってから設定する
+	for (const TPair<FGameplayAttribute, float>& Pair : Snapshot.VitalBaseValues)
+	{
+		ASC->SetNumericAttributeBase(Pair.Key, Pair.Value);
+	}
+
+	INC_DWORD_STAT(STAT_AuraAttributeSnapshotsApplied);
+}
@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AbilitySystem/AuraTagReplicationProfiler.h"
+#include "GameplayTagsManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static bool GAuraProfileTagReplication = false;
+static FAutoConsoleVariableRef CVarAuraProfileTagReplication(
+	TEXT("Aura.TagReplication.Enable"),
+	GAuraProfileTagReplication,
+	TEXT("Counts gameplay tags sent on Aura replication paths per connection (development builds, server only)."));
+
+static FAutoConsoleCommandWithWorld CVarAuraTagReplicationWriteReport(
+	TEXT("Aura.TagReplication.WriteReport"),
+	TEXT("Writes the ordered CommonlyReplicatedTags list and a suggested NetIndexFirstBitSegment to Saved/Profiling/."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const UAuraTagReplicationProfiler* Profiler = World ? World->GetSubsystem<UAuraTagReplicationProfiler>() : nullptr;
+		if (!Profiler) return;
+
+		FString Filename;
+		if (Profiler->WriteReport(Filename))
+		{
+			UE_LOG(LogTemp, Log, TEXT("Tag replication report written to %s"), *Filename);
+		}
+	})
+);
+
+static FAutoConsoleCommandWithWorld CVarAuraTagReplicationReset(
+	TEXT("Aura.TagReplication.Reset"),
+	TEXT("Clears the recorded tag replication counts."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UAuraTagReplicationProfiler* Profiler = World ? World->GetSubsystem<UAuraTagReplicationProfiler>() : nullptr)
+		{
+			Profiler->Reset();
+		}
+	})
+);
+
+namespace AuraTagReplication
+{
+	// SerializeTagNetIndexPacked と同じ計算: 第1セグメントに収まれば FirstSegment + 1 ビット、それ以外は TotalBits + 1 ビット
+	int64 PackedBits(int32 NetIndex, int32 FirstSegment, int32 TotalBits)
+	{
+		if (FirstSegment <= 0 || FirstSegment >= TotalBits)
+		{
+			return TotalBits;
+		}
+		return NetIndex < (1 << FirstSegment) ? FirstSegment + 1 : TotalBits + 1;
+	}
+}
+
+bool UAuraTagReplicationProfiler::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if AURA_TAG_REPLICATION_PROFILER
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+void UAuraTagReplicationProfiler::RecordTags(const AActor* Owner, const FGameplayTagContainer& Tags)
+{
+#if AURA_TAG_REPLICATION_PROFILER
+	if (!GAuraProfileTagReplication || !Owner || Tags.IsEmpty()) return;
+
+	const UNetConnection* Connection = Owner->GetNetConnection();
+	UAuraTagReplicationProfiler* Profiler = Owner->GetWorld() ? Owner->GetWorld()->GetSubsystem<UAuraTagReplicationProfiler>() : nullptr;
+	if (Connection && Profiler)
+	{
+		Profiler->RecordTagsInternal(Connection, Tags);
+	}
+#endif
+}
+
+void UAuraTagReplicationProfiler::RecordTagsForAllConnections(const UWorld* World, const FGameplayTagContainer& Tags)
+{
+#if AURA_TAG_REPLICATION_PROFILER
+	if (!GAuraProfileTagReplication || !World || Tags.IsEmpty()) return;
+
+	UAuraTagReplicationProfiler* Profiler = World->GetSubsystem<UAuraTagReplicationProfiler>();
+	const UNetDriver* NetDriver = World->GetNetDriver();
+	if (!Profiler || !NetDriver) return;
+
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			Profiler->RecordTagsInternal(Connection, Tags);
+		}
+	}
+#endif
+}
+
+void UAuraTagReplicationProfiler::RecordTagsInternal(const UNetConnection* Connection, const FGameplayTagContainer& Tags)
+{
+	TMap<FGameplayTag, int64>& ConnectionCounts = ConnectionTagCounts.FindOrAdd(Connection->LowLevelGetRemoteAddress(true));
+	for (const FGameplayTag& Tag : Tags)
+	{
+		++ConnectionCounts.FindOrAdd(Tag);
+		++TotalTagCounts.FindOrAdd(Tag);
+	}
+}
+
+void UAuraTagReplicationProfiler::Reset()
+{
+	ConnectionTagCounts.Reset();
+	TotalTagCounts.Reset();
+}
+
+bool UAuraTagReplicationProfiler::WriteReport(FString& OutFilename) const
+{
+	if (TotalTagCounts.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No tag replication recorded, enable with Aura.TagReplication.Enable 1."));
+		return false;
+	}
+
+	// 回数の多い順（同数ならタグ名順）
+	TArray<TPair<FGameplayTag, int64>> SortedTags = TotalTagCounts.Array();
+	SortedTags.Sort([](const TPair<FGameplayTag, int64>& A, const TPair<FGameplayTag, int64>& B)
+	{
+		return A.Value != B.Value ? A.Value > B.Value : A.Key.GetTagName().LexicalLess(B.Key.GetTagName());
+	});
+
+	FGameplayTagContainer AllTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, true);
+	const int32 TotalBits = FMath::Max(1, static_cast<int32>(FMath::CeilLogTwo(AllTags.Num() + 1)));
+
+	// CommonlyReplicatedTagsは先頭のネットインデックスを使う（0は予約として1から数える）
+	int32 BestSegment = 0;
+	int64 BestBits = MAX_int64;
+	int64 UnsegmentedBits = 0;
+	for (int32 FirstSegment = 0; FirstSegment < TotalBits; ++FirstSegment)
+	{
+		int64 Bits = 0;
+		for (int32 Rank = 0; Rank < SortedTags.Num(); ++Rank)
+		{
+			Bits += SortedTags[Rank].Value * AuraTagReplication::PackedBits(Rank + 1, FirstSegment, TotalBits);
+		}
+		if (FirstSegment == 0)
+		{
+			UnsegmentedBits = Bits;
+		}
+		if (Bits < BestBits)
+		{
+			BestBits = Bits;
+			BestSegment = FirstSegment;
+		}
+	}
+
+	FString Report;
+	Report += FString::Printf(TEXT("; Aura tag replication report %s\n"), *FDateTime::Now().ToString());
+	Report += FString::Printf(TEXT("; %d registered tags (%d bits per net index), %d distinct tags sent\n"), AllTags.Num(), TotalBits, SortedTags.Num());
+	Report += FString::Printf(TEXT("; Estimated tag bits: %lld without a first segment, %lld with NetIndexFirstBitSegment=%d\n"), UnsegmentedBits, BestBits, BestSegment);
+
+	for (const TPair<FString, TMap<FGameplayTag, int64>>& Connection : ConnectionTagCounts)
+	{
+		int64 ConnectionTotal = 0;
+		for (const TPair<FGameplayTag, int64>& Count : Connection.Value)
+		{
+			ConnectionTotal += Count.Value;
+		}
+		Report += FString::Printf(TEXT("; [%s] %lld tags, %d distinct\n"), *Connection.Key, ConnectionTotal, Connection.Value.Num());
+	}
+
+	for (const TPair<FGameplayTag, int64>& Pair : SortedTags)
+	{
+		Report += FString::Printf(TEXT(";   %lld %s\n"), Pair.Value, *Pair.Key.ToString());
+	}
+
+	// DefaultGameplayTags.iniにそのまま貼れる形式
+	Report += TEXT("\n[/Script/GameplayTags.GameplayTagsSettings]\n");
+	Report += TEXT("FastReplication=True\n");
+	Report += FString::Printf(TEXT("NetIndexFirstBitSegment=%d\n"), BestSegment);
+	for (const TPair<FGameplayTag, int64>& Pair : SortedTags)
+	{
+		Report += FString::Printf(TEXT("+CommonlyReplicatedTags=%s\n"), *Pair.Key.ToString());
+	}
+
+	OutFilename = FPaths::Combine(FPaths::ProfilingDir(), TEXT("AuraTagReplication.ini"));
+	return FFileHelper::SaveStringToFile(Report, *OutFilename);
+}
@@ -3,14 +3,46 @@
 
 #include "AbilitySystem/Data/AttributeInfo.h"
 
-FAuraAttributeInfo UAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound) const
+void UAttributeInfo::PostLoad()
 {
-	for (const FAuraAttributeInfo& Info : AttributeInformation)
+	Super::PostLoad();
+
+	BuildIndex();
+}
+
+#if WITH_EDITOR
+void UAttributeInfo::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BuildIndex();
+}
+#endif
+
+void UAttributeInfo::BuildIndex()
+{
+	AttributeIndexByTag.Reset();
+	AttributeIndexByTag.Reserve(AttributeInformation.Num());
+
+	for (int32 Index = 0; Index < AttributeInformation.Num(); ++Index)
 	{
-		if (Info.AttributeTag.MatchesTag(AttributeTag))
+		const FGameplayTag& Tag = AttributeInformation[Index].AttributeTag;
+		if (!Tag.IsValid()) continue;
+
+		if (AttributeIndexByTag.Contains(Tag))
 		{
-			return Info;
+			UE_LOG(LogTemp, Warning, TEXT("Duplicate AttributeTag [%s] on AttributeInfo [%s]."), *Tag.ToString(), *GetNameSafe(this));
+			continue;
 		}
+		AttributeIndexByTag.Add(Tag, Index);
+	}
+}
+
+const FAuraAttributeInfo& UAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound) const
+{
+	if (const int32* Index = AttributeIndexByTag.Find(AttributeTag))
+	{
+		return AttributeInformation[*Index];
 	}
 
 	if (bLogNotFound)
@@ -19,5 +51,6 @@ FAuraAttributeInfo UAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& A
 		
 	}
 
-	return FAuraAttributeInfo();
+	static const FAuraAttributeInfo EmptyInfo;
+	return EmptyInfo;
 }
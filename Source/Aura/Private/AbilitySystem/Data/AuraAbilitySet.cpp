@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AbilitySystem/Data/AuraAbilitySet.h"
+#include "AbilitySystem/Abilities/AuraGameplayAbility.h"
+
+const TArray<FGameplayAbilitySpec>& UAuraAbilitySet::GetSpecTemplates() const
+{
+	if (!bSpecTemplatesBuilt)
+	{
+		BuildSpecTemplates();
+	}
+	return SpecTemplates;
+}
+
+#if WITH_EDITOR
+void UAuraAbilitySet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	bSpecTemplatesBuilt = false;
+}
+#endif
+
+void UAuraAbilitySet::BuildSpecTemplates() const
+{
+	SpecTemplates.Reset(GrantedAbilities.Num());
+
+	for (const FAuraAbilitySetEntry& Entry : GrantedAbilities)
+	{
+		if (!IsValid(Entry.Ability))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Invalid Ability class in AbilitySet [%s]."), *GetNameSafe(this));
+			continue;
+		}
+
+		FGameplayAbilitySpec& AbilitySpec = SpecTemplates.Emplace_GetRef(Entry.Ability, Entry.AbilityLevel);
+
+		FGameplayTag InputTag = Entry.InputTag;
+		if (!InputTag.IsValid())
+		{
+			if (const UAuraGameplayAbility* AuraAbility = Cast<UAuraGameplayAbility>(AbilitySpec.Ability))
+			{
+				InputTag = AuraAbility->StartupInputTag;
+			}
+		}
+
+		if (InputTag.IsValid())
+		{
+			AbilitySpec.DynamicAbilityTags.AddTag(InputTag);
+		}
+	}
+
+	bSpecTemplatesBuilt = true;
+}
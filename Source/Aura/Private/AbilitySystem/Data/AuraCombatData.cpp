@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AbilitySystem/Data/AuraCombatData.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FAuraCombatData FAuraCombatData::CombatData;
+
+FAuraCombatData::~FAuraCombatData()
+{
+}
+
+void FAuraCombatData::Initialize()
+{
+	const FString Filename = GetDefaultFilename();
+	if (!CombatData.Load(Filename))
+	{
+		UE_LOG(LogTemp, Log, TEXT("AuraCombatData: [%s] not available, default attribute effects are applied as usual."), *Filename);
+	}
+}
+
+FString FAuraCombatData::GetDefaultFilename()
+{
+	// パッケージ時はNonUFSとして配置する（DefaultGame.ini DirectoriesToAlwaysStageAsNonUFS）
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("CombatData"), TEXT("AuraCombatData.bin"));
+}
+
+uint64 FAuraCombatData::HashName(FStringView Name)
+{
+	const FString Lower = FString(Name).ToLower();
+	return CityHash64(reinterpret_cast<const char*>(*Lower), Lower.Len() * sizeof(TCHAR));
+}
+
+bool FAuraCombatData::HashEffectSource(const UGameplayEffect* Effect, int32 Level, uint64& OutHash)
+{
+	if (!Effect || Effect->DurationPolicy != EGameplayEffectDurationType::Instant) return false;
+
+	OutHash = HashName(Effect->GetClass()->GetPathName());
+	for (const FGameplayModifierInfo& Modifier : Effect->Modifiers)
+	{
+		float Value = 0.f;
+		if (Modifier.ModifierOp != EGameplayModOp::Override || !Modifier.ModifierMagnitude.GetStaticMagnitudeIfPossible(Level, Value))
+		{
+			return false;
+		}
+
+		OutHash = CityHash128to64(Uint128_64(OutHash, HashName(Modifier.Attribute.GetName())));
+		OutHash = CityHash128to64(Uint128_64(OutHash, (static_cast<uint64>(Modifier.ModifierOp) << 32) | GetTypeHash(Value)));
+	}
+	return true;
+}
+
+bool FAuraCombatData::Load(const FString& Filename)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Filename)) return false;
+
+	// 同じホストのサーバープロセス間でページを共有できるよう、まずメモリマップを試す
+	MappedFile.Reset(PlatformFile.OpenMapped(*Filename));
+	if (MappedFile.IsValid())
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackData, *Filename)) return false;
+
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+
+	if (!Validate())
+	{
+		MappedRegion.Reset();
+		MappedFile.Reset();
+		FallbackData.Empty();
+		Data = nullptr;
+		DataSize = 0;
+		Header = nullptr;
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("AuraCombatData: %s %lld bytes (%llu attribute defaults)."),
+		MappedRegion.IsValid() ? TEXT("mapped") : TEXT("loaded"), DataSize, Header->NumAttributeDefaults);
+	return true;
+}
+
+bool FAuraCombatData::Validate()
+{
+	if (DataSize < static_cast<int64>(sizeof(FAuraCombatDataHeader))) return false;
+
+	const FAuraCombatDataHeader* Candidate = reinterpret_cast<const FAuraCombatDataHeader*>(Data);
+	if (Candidate->Magic != AuraCombatDataMagic ||
+		Candidate->Version != AuraCombatDataVersion ||
+		Candidate->NativeTagCount != AuraNativeTagCount ||
+		Candidate->FileSize != static_cast<uint64>(DataSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AuraCombatData: header mismatch (version %u, expected %u). Re-run the AuraBakeCombatData commandlet."),
+			Candidate->Version, AuraCombatDataVersion);
+		return false;
+	}
+
+	auto InRange = [this](uint64 Offset, uint64 Count, uint64 ElementSize)
+	{
+		return Offset <= static_cast<uint64>(DataSize) && Count * ElementSize <= static_cast<uint64>(DataSize) - Offset;
+	};
+
+	if (!InRange(Candidate->AttributeDefaultsOffset, Candidate->NumAttributeDefaults, sizeof(FAuraBakedAttributeDefaults)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AuraCombatData: section out of range, file is corrupt."));
+		return false;
+	}
+
+	Header = Candidate;
+	return true;
+}
+
+const FAuraBakedAttributeDefaults* FAuraCombatData::FindAttributeDefaults(const UClass* EffectClass, int32 Level) const
+{
+	if (!Header || !EffectClass || Header->NumAttributeDefaults == 0) return nullptr;
+
+	const FAuraBakedAttributeDefaults* Rows = reinterpret_cast<const FAuraBakedAttributeDefaults*>(Data + Header->AttributeDefaultsOffset);
+	const TArrayView<const FAuraBakedAttributeDefaults> RowView(Rows, static_cast<int32>(Header->NumAttributeDefaults));
+
+	const uint64 EffectHash = HashName(EffectClass->GetPathName());
+	const int32 Index = Algo::LowerBound(RowView, TPair<uint64, int32>(EffectHash, Level),
+		[](const FAuraBakedAttributeDefaults& Row, const TPair<uint64, int32>& Key)
+		{
+			return Row.EffectHash != Key.Key ? Row.EffectHash < Key.Key : Row.Level < Key.Value;
+		});
+
+	if (!RowView.IsValidIndex(Index) || RowView[Index].EffectHash != EffectHash || RowView[Index].Level != Level)
+	{
+		return nullptr;
+	}
+
+	// ベイク後にGE（Modifierやカーブテーブル）が変更されていたら、古い値を使わずGEを適用させる
+	const TPair<TObjectKey<UClass>, int32> Key(EffectClass, Level);
+	const bool* bMatches = SourceHashMatches.Find(Key);
+	if (!bMatches)
+	{
+		uint64 SourceHash = 0;
+		const bool bValid = HashEffectSource(EffectClass->GetDefaultObject<UGameplayEffect>(), Level, SourceHash) && SourceHash == RowView[Index].SourceHash;
+		if (!bValid)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AuraCombatData: baked defaults for [%s] level %d are stale. Re-run the AuraBakeCombatData commandlet."), *EffectClass->GetName(), Level);
+		}
+		bMatches = &SourceHashMatches.Add(Key, bValid);
+	}
+	return *bMatches ? &RowView[Index] : nullptr;
+}
+
+bool FAuraCombatData::ApplyAttributeDefaults(const UClass* EffectClass, int32 Level, UAbilitySystemComponent* ASC) const
+{
+	const FAuraBakedAttributeDefaults* Defaults = FindAttributeDefaults(EffectClass, Level);
+	if (!Defaults || !ASC) return false;
+
+	const TMap<FGameplayTag, TStaticFuncPtr<FGameplayAttribute()>>& TagsToAttributes = GetDefault<UAuraAttributeSet>()->TagsToAttributes;
+	for (int32 Index = 0; Index < AuraNativeTagCount; ++Index)
+	{
+		const EAuraNativeTag NativeTag = static_cast<EAuraNativeTag>(Index);
+		if (!(Defaults->ValidMask & AuraNativeTagBit(NativeTag))) continue;
+
+		if (const TStaticFuncPtr<FGameplayAttribute()>* Attribute = TagsToAttributes.Find(FAuraGameplayTags::Get().GetNativeTag(NativeTag)))
+		{
+			ASC->SetNumericAttributeBase((*Attribute)(), Defaults->Values[Index]);
+		}
+	}
+	return true;
+}
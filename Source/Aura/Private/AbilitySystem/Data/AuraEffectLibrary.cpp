@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AbilitySystem/Data/AuraEffectLibrary.h"
+#include "GameplayEffect.h"
+
+TSubclassOf<UGameplayEffect> UAuraEffectLibrary::FindEffectForTag(const FGameplayTag& EffectTag) const
+{
+	if (const TSoftClassPtr<UGameplayEffect>* Effect = Effects.Find(EffectTag))
+	{
+		return Effect->Get();
+	}
+	return nullptr;
+}
@@ -30,5 +30,5 @@ float UMMC_MaxMana::CalculateBaseMagnitude_Implementation(const FGameplayEffectS
 	ICombatInterface* CombatInterface = Cast<ICombatInterface>( Spec.GetContext().GetSourceObject());
 	const int32 PlayerLevel = CombatInterface->GetPlayerLevel();
 
-	return 50.f + 2.5f * Intelligence + 15.f * PlayerLevel;
+	return Base + PerIntelligence * Intelligence + PerLevel * PlayerLevel;
 }
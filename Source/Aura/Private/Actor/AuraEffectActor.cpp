@@ -3,17 +3,37 @@
 #include "Actor/AuraEffectActor.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
+#include "AuraSpatialHashSubsystem.h"
 
 AAuraEffectActor::AAuraEffectActor()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
+	// 状態を持たないので、ReplicationGraphのピックアップノードで休止させたままにする
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
 	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot")));
 }
 
 void AAuraEffectActor::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UAuraSpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>())
+	{
+		SpatialHash->RegisterActor(this, EAuraSpatialCategory::EffectActor);
+	}
+}
+
+void AAuraEffectActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraSpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>())
+	{
+		SpatialHash->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAuraEffectActor::ApplyEffectToTarget(AActor* TargetActor, TSubclassOf<UGameplayEffect> GameplayEffectClass)
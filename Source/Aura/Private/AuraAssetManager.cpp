@@ -4,8 +4,18 @@
 #include "AuraAssetManager.h"
 #include "AuraGameplayTags.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/Data/AuraCombatData.h"
 #include  "AbilitySystemGlobals.h"
+#include "Engine/StreamableManager.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
+const FPrimaryAssetType UAuraAssetManager::AbilitySetType(TEXT("AuraAbilitySet"));
+const FPrimaryAssetType UAuraAssetManager::CharacterClassType(TEXT("AuraCharacterClassInfo"));
+const FPrimaryAssetType UAuraAssetManager::EffectLibraryType(TEXT("AuraEffectLibrary"));
+
+const FName UAuraAssetManager::StartupBundle(TEXT("Startup"));
+const FName UAuraAssetManager::CombatBundle(TEXT("Combat"));
+const FName UAuraAssetManager::UIBundle(TEXT("UI"));
 
 UAuraAssetManager& UAuraAssetManager::Get()
 {
@@ -17,10 +27,87 @@ UAuraAssetManager& UAuraAssetManager::Get()
 
 void UAuraAssetManager::StartInitialLoading()
 {
+	// フェーズごとの所要時間をログに出す
+	const double StartTime = FPlatformTime::Seconds();
+	double PhaseStart = StartTime;
+	auto EndPhase = [&PhaseStart](const TCHAR* PhaseName)
+	{
+		const double Now = FPlatformTime::Seconds();
+		UE_LOG(LogTemp, Log, TEXT("AuraAssetManager: %s took %.2f ms"), PhaseName, (Now - PhaseStart) * 1000.0);
+		PhaseStart = Now;
+	};
+
 	Super::StartInitialLoading();
+	EndPhase(TEXT("Primary asset scan"));
 
 	FAuraGameplayTags::InitializeNativeGameplayTags();
+	EndPhase(TEXT("Native gameplay tags"));
 
 	// Target Data使用のための初期化(Target Data型の登録）
 	UAbilitySystemGlobals::Get().InitGlobalData();
+	EndPhase(TEXT("AbilitySystemGlobals::InitGlobalData"));
+
+	// ベイク済み戦闘データをメモリマップする（ネイティブタグの登録後）
+	if (!IsRunningCommandlet())
+	{
+		FAuraCombatData::Initialize();
+		EndPhase(TEXT("Combat data"));
+	}
+
+	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UAuraAssetManager::OnPreLoadMap);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UAuraAssetManager::OnPostLoadMap);
+
+	UE_LOG(LogTemp, Log, TEXT("AuraAssetManager: StartInitialLoading took %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UAuraAssetManager::PreloadGameplayBundles()
+{
+	// 読み込み中、または読み込み済み
+	if (GameplayBundlesHandle.IsValid()) return;
+
+	TArray<FPrimaryAssetId> AssetIds;
+	for (const FPrimaryAssetType& Type : { AbilitySetType, CharacterClassType, EffectLibraryType })
+	{
+		GetPrimaryAssetIdList(Type, AssetIds);
+	}
+	if (AssetIds.Num() == 0) return;
+
+	GameplayBundlesRequestTime = FPlatformTime::Seconds();
+	TRACE_BOOKMARK(TEXT("Aura.GameplayBundlesRequested"));
+
+	const TArray<FName> Bundles = { StartupBundle, CombatBundle, UIBundle };
+	GameplayBundlesHandle = LoadPrimaryAssets(AssetIds, Bundles,
+		FStreamableDelegate::CreateUObject(this, &UAuraAssetManager::OnGameplayBundlesLoaded));
+}
+
+void UAuraAssetManager::OnPreLoadMap(const FString& MapName)
+{
+	if (IsRunningDedicatedServer() || IsRunningCommandlet()) return;
+
+	PreloadGameplayBundles();
+}
+
+void UAuraAssetManager::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (GameplayBundlesHandle.IsValid() && GameplayBundlesHandle->IsLoadingInProgress())
+	{
+		UE_LOG(LogTemp, Log, TEXT("AuraAssetManager: map loaded, gameplay bundles still streaming (%.0f%%)."),
+			GameplayBundlesHandle->GetProgress() * 100.f);
+	}
+}
+
+void UAuraAssetManager::OnGameplayBundlesLoaded()
+{
+	TRACE_BOOKMARK(TEXT("Aura.GameplayBundlesLoaded"));
+
+	int32 NumLoaded = 0;
+	if (GameplayBundlesHandle.IsValid())
+	{
+		TArray<UObject*> LoadedAssets;
+		GameplayBundlesHandle->GetLoadedAssets(LoadedAssets);
+		NumLoaded = LoadedAssets.Num();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("AuraAssetManager: preloaded %d assets (Startup/Combat/UI) in %.2f ms"),
+		NumLoaded, (FPlatformTime::Seconds() - GameplayBundlesRequestTime) * 1000.0);
 }
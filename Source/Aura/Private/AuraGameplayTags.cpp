@@ -112,5 +112,68 @@ void FAuraGameplayTags::InitializeNativeGameplayTags()
 		FName("InputTag.4"),
 		FString("Input Tag for 4 key")
 	);
+
+	// Message Tags
+	GameplayTags.Message = UGameplayTagsManager::Get().AddNativeGameplayTag(
+		FName("Message"),
+		FString("Parent tag for effect messages shown on the overlay")
+	);
+
+	// EAuraNativeTagと同じ順番
+	const FGameplayTag* IndexedTags[] =
+	{
+		&GameplayTags.Attributes_Primary_Strength,
+		&GameplayTags.Attributes_Primary_Intelligence,
+		&GameplayTags.Attributes_Primary_Resilience,
+		&GameplayTags.Attributes_Primary_Vigor,
+		&GameplayTags.Attributes_Secondary_Armor,
+		&GameplayTags.Attributes_Secondary_ArmorPenetration,
+		&GameplayTags.Attributes_Secondary_BlockChance,
+		&GameplayTags.Attributes_Secondary_CriticalHitChance,
+		&GameplayTags.Attributes_Secondary_CriticalHitDamage,
+		&GameplayTags.Attributes_Secondary_CriticalHitResistance,
+		&GameplayTags.Attributes_Secondary_HealthRegeneration,
+		&GameplayTags.Attributes_Secondary_ManaRegeneration,
+		&GameplayTags.Attributes_Secondary_MaxHealth,
+		&GameplayTags.Attributes_Secondary_MaxMana,
+		&GameplayTags.InputTag_LMB,
+		&GameplayTags.InputTag_RMB,
+		&GameplayTags.InputTag_1,
+		&GameplayTags.InputTag_2,
+		&GameplayTags.InputTag_3,
+		&GameplayTags.InputTag_4,
+		&GameplayTags.Message,
+	};
+	static_assert(UE_ARRAY_COUNT(IndexedTags) == AuraNativeTagCount, "Update IndexedTags when EAuraNativeTag changes");
+
+	GameplayTags.NativeTagIndices.Reset();
+	for (int32 Index = 0; Index < AuraNativeTagCount; ++Index)
+	{
+		GameplayTags.NativeTags[Index] = *IndexedTags[Index];
+		GameplayTags.NativeTagIndices.Add(*IndexedTags[Index], static_cast<EAuraNativeTag>(Index));
+	}
 	
 }
+
+FAuraNativeTagBits FAuraGameplayTags::GetMatchBits(const FGameplayTag& Tag) const
+{
+	FAuraNativeTagBits Bits = 0;
+	for (FGameplayTag Current = Tag; Current.IsValid(); Current = Current.RequestDirectParent())
+	{
+		if (const EAuraNativeTag* NativeTag = NativeTagIndices.Find(Current))
+		{
+			Bits |= AuraNativeTagBit(*NativeTag);
+		}
+	}
+	return Bits;
+}
+
+FAuraNativeTagBits FAuraGameplayTags::GetMatchBits(const FGameplayTagContainer& Container) const
+{
+	FAuraNativeTagBits Bits = 0;
+	for (const FGameplayTag& Tag : Container)
+	{
+		Bits |= GetMatchBits(Tag);
+	}
+	return Bits;
+}
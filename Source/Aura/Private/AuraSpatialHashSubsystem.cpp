@@ -0,0 +1,324 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AuraSpatialHashSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spatial Hash Update"), STAT_AuraSpatialHashUpdate, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spatial Hash Moved Entries"), STAT_AuraSpatialHashMovedEntries, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spatial Hash Entries"), STAT_AuraSpatialHashEntries, STATGROUP_Aura);
+
+FIntPoint FAuraSpatialHashSnapshot::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+template<typename FunctionType>
+void FAuraSpatialHashSnapshot::ForEachInCellRange(const FIntPoint& MinCell, const FIntPoint& MaxCell, FunctionType&& Function) const
+{
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const TPair<int32, int32>* Range = CellRanges.Find(FIntPoint(X, Y));
+			if (!Range) continue;
+
+			for (int32 Index = Range->Key; Index < Range->Key + Range->Value; ++Index)
+			{
+				Function(Entries[Index]);
+			}
+		}
+	}
+}
+
+void FAuraSpatialHashSnapshot::QueryRadius(const FVector& Center, float Radius, EAuraSpatialCategory CategoryMask, TArray<FAuraSpatialHashEntry>& OutEntries) const
+{
+	// 半径の大きいエントリが隣のセルにいても拾えるよう1セル広げる
+	const FVector Extent(Radius + CellSize, Radius + CellSize, 0.f);
+	ForEachInCellRange(ToCell(Center - Extent), ToCell(Center + Extent), [&](const FAuraSpatialHashEntry& Entry)
+	{
+		if (!EnumHasAnyFlags(Entry.Category, CategoryMask)) return;
+		if (FVector::DistSquared(Center, Entry.Location) <= FMath::Square(Radius + Entry.Radius))
+		{
+			OutEntries.Add(Entry);
+		}
+	});
+}
+
+void FAuraSpatialHashSnapshot::QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, EAuraSpatialCategory CategoryMask, TArray<FAuraSpatialHashEntry>& OutEntries) const
+{
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+	const FVector Extent(Range + CellSize, Range + CellSize, 0.f);
+	ForEachInCellRange(ToCell(Origin - Extent), ToCell(Origin + Extent), [&](const FAuraSpatialHashEntry& Entry)
+	{
+		if (!EnumHasAnyFlags(Entry.Category, CategoryMask)) return;
+
+		const FVector ToEntry = Entry.Location - Origin;
+		const float DistSquared = ToEntry.SizeSquared();
+		if (DistSquared > FMath::Square(Range + Entry.Radius)) return;
+
+		// 原点と重なっているものは方向に関係なく含める
+		if (DistSquared <= FMath::Square(Entry.Radius) || (ToEntry * FMath::InvSqrt(DistSquared) | Direction) >= CosHalfAngle)
+		{
+			OutEntries.Add(Entry);
+		}
+	});
+}
+
+void FAuraSpatialHashSnapshot::QueryNearest(const FVector& Location, int32 Count, float MaxRadius, EAuraSpatialCategory CategoryMask, TArray<FAuraSpatialHashEntry>& OutEntries) const
+{
+	if (Count <= 0) return;
+
+	// (距離の2乗, インデックス) の最大ヒープでCount個を保持する
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Best;
+	auto Less = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; };
+
+	const FIntPoint CenterCell = ToCell(Location);
+	const int32 MaxRing = FMath::CeilToInt32(MaxRadius / CellSize);
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// リングRの中のエントリは少なくとも (R - 1) * CellSize 離れている
+		const float RingMinDistance = FMath::Max(0, Ring - 1) * CellSize;
+		if (Best.Num() == Count && FMath::Square(RingMinDistance) > Best.HeapTop().Key) break;
+
+		for (int32 Y = -Ring; Y <= Ring; ++Y)
+		{
+			for (int32 X = -Ring; X <= Ring; ++X)
+			{
+				// リングの外周のセルだけ
+				if (FMath::Max(FMath::Abs(X), FMath::Abs(Y)) != Ring) continue;
+
+				const TPair<int32, int32>* Range = CellRanges.Find(CenterCell + FIntPoint(X, Y));
+				if (!Range) continue;
+
+				for (int32 Index = Range->Key; Index < Range->Key + Range->Value; ++Index)
+				{
+					const FAuraSpatialHashEntry& Entry = Entries[Index];
+					if (!EnumHasAnyFlags(Entry.Category, CategoryMask)) continue;
+
+					const float DistSquared = FVector::DistSquared(Location, Entry.Location);
+					if (DistSquared > FMath::Square(MaxRadius)) continue;
+
+					if (Best.Num() < Count)
+					{
+						Best.HeapPush(TPair<float, int32>(DistSquared, Index), Less);
+					}
+					else if (DistSquared < Best.HeapTop().Key)
+					{
+						Best.HeapPopDiscard(Less, false);
+						Best.HeapPush(TPair<float, int32>(DistSquared, Index), Less);
+					}
+				}
+			}
+		}
+	}
+
+	Best.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	for (const TPair<float, int32>& Pair : Best)
+	{
+		OutEntries.Add(Entries[Pair.Value]);
+	}
+}
+
+bool UAuraSpatialHashSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UAuraSpatialHashSubsystem::Deinitialize()
+{
+	for (FLiveEntry& Entry : LiveEntries)
+	{
+		if (AActor* Actor = Entry.Actor.Get())
+		{
+			if (USceneComponent* Root = Actor->GetRootComponent())
+			{
+				Root->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+			}
+		}
+	}
+	LiveEntries.Empty();
+	FreeEntryIndices.Empty();
+	DirtyEntryIndices.Empty();
+	EntryIndexByActor.Empty();
+	LiveCells.Empty();
+
+	{
+		FScopeLock Lock(&SnapshotLock);
+		PublishedSnapshot.Reset();
+		BackSnapshot.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId UAuraSpatialHashSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraSpatialHashSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UAuraSpatialHashSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UAuraSpatialHashSubsystem::RegisterActor(AActor* Actor, EAuraSpatialCategory Category)
+{
+	USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr;
+	if (!Root || EntryIndexByActor.Contains(Actor)) return;
+
+	const int32 EntryIndex = FreeEntryIndices.Num() > 0 ? FreeEntryIndices.Pop(false) : LiveEntries.AddDefaulted();
+	FLiveEntry& Entry = LiveEntries[EntryIndex];
+	Entry.Actor = Actor;
+	Entry.Category = Category;
+	Entry.Cell = ToCell(Actor->GetActorLocation());
+	// キャラクターはカプセルの半径、ルートに形状が無いアクターはコンポーネント全体の大きさ
+	Entry.Radius = Actor->GetSimpleCollisionRadius();
+	if (Entry.Radius <= 0.f)
+	{
+		Entry.Radius = Actor->GetComponentsBoundingBox(true).GetExtent().Size2D();
+	}
+	Entry.bDirty = false;
+	Entry.TransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &UAuraSpatialHashSubsystem::OnTransformUpdated, EntryIndex);
+
+	EntryIndexByActor.Add(Actor, EntryIndex);
+	LiveCells.FindOrAdd(Entry.Cell).Add(EntryIndex);
+	bSnapshotDirty = true;
+}
+
+void UAuraSpatialHashSubsystem::UnregisterActor(AActor* Actor)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndexByActor.RemoveAndCopyValue(Actor, EntryIndex)) return;
+
+	FLiveEntry& Entry = LiveEntries[EntryIndex];
+	if (USceneComponent* Root = Actor->GetRootComponent())
+	{
+		Root->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+	}
+
+	RemoveFromCell(EntryIndex);
+	DirtyEntryIndices.RemoveSwap(EntryIndex, false);
+	Entry = FLiveEntry();
+	FreeEntryIndices.Add(EntryIndex);
+	bSnapshotDirty = true;
+}
+
+void UAuraSpatialHashSubsystem::OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 EntryIndex)
+{
+	FLiveEntry& Entry = LiveEntries[EntryIndex];
+	if (!Entry.bDirty)
+	{
+		Entry.bDirty = true;
+		DirtyEntryIndices.Add(EntryIndex);
+	}
+}
+
+void UAuraSpatialHashSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+	const FIntPoint Cell = LiveEntries[EntryIndex].Cell;
+	if (TArray<int32>* CellEntries = LiveCells.Find(Cell))
+	{
+		CellEntries->RemoveSwap(EntryIndex, false);
+		if (CellEntries->IsEmpty())
+		{
+			LiveCells.Remove(Cell);
+		}
+	}
+}
+
+void UAuraSpatialHashSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushPendingUpdates();
+}
+
+void UAuraSpatialHashSubsystem::FlushPendingUpdates()
+{
+	SET_DWORD_STAT(STAT_AuraSpatialHashMovedEntries, DirtyEntryIndices.Num());
+	SET_DWORD_STAT(STAT_AuraSpatialHashEntries, EntryIndexByActor.Num());
+	if (DirtyEntryIndices.IsEmpty() && !bSnapshotDirty) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AuraSpatialHashUpdate);
+
+	// 移動したものだけセルを付け替える
+	for (const int32 EntryIndex : DirtyEntryIndices)
+	{
+		FLiveEntry& Entry = LiveEntries[EntryIndex];
+		Entry.bDirty = false;
+
+		const AActor* Actor = Entry.Actor.Get();
+		if (!Actor) continue;
+
+		const FIntPoint NewCell = ToCell(Actor->GetActorLocation());
+		if (NewCell != Entry.Cell)
+		{
+			RemoveFromCell(EntryIndex);
+			Entry.Cell = NewCell;
+			LiveCells.FindOrAdd(NewCell).Add(EntryIndex);
+		}
+	}
+	DirtyEntryIndices.Reset();
+
+	// セルを移らなくても位置は変わっているのでスナップショットは作り直す
+	PublishSnapshot();
+	bSnapshotDirty = false;
+}
+
+void UAuraSpatialHashSubsystem::PublishSnapshot()
+{
+	// 前回のスナップショットを誰も参照していなければ再利用する（ダブルバッファ）
+	TSharedPtr<FAuraSpatialHashSnapshot, ESPMode::ThreadSafe> Snapshot;
+	{
+		FScopeLock Lock(&SnapshotLock);
+		if (BackSnapshot.IsValid() && BackSnapshot.IsUnique())
+		{
+			Snapshot = MoveTemp(BackSnapshot);
+		}
+	}
+	if (!Snapshot.IsValid())
+	{
+		Snapshot = MakeShared<FAuraSpatialHashSnapshot, ESPMode::ThreadSafe>();
+	}
+
+	Snapshot->CellSize = CellSize;
+	Snapshot->Entries.Reset(EntryIndexByActor.Num());
+	Snapshot->CellRanges.Reset();
+
+	for (const TPair<FIntPoint, TArray<int32>>& Cell : LiveCells)
+	{
+		const int32 Start = Snapshot->Entries.Num();
+		for (const int32 EntryIndex : Cell.Value)
+		{
+			const FLiveEntry& LiveEntry = LiveEntries[EntryIndex];
+			const AActor* Actor = LiveEntry.Actor.Get();
+
+			// プールで待機中の敵など、非表示のものは含めない
+			if (!Actor || Actor->IsHidden()) continue;
+
+			FAuraSpatialHashEntry& Entry = Snapshot->Entries.AddDefaulted_GetRef();
+			Entry.Actor = LiveEntry.Actor;
+			Entry.Location = Actor->GetActorLocation();
+			Entry.Radius = LiveEntry.Radius;
+			Entry.Category = LiveEntry.Category;
+		}
+		if (Snapshot->Entries.Num() > Start)
+		{
+			Snapshot->CellRanges.Add(Cell.Key, TPair<int32, int32>(Start, Snapshot->Entries.Num() - Start));
+		}
+	}
+
+	FScopeLock Lock(&SnapshotLock);
+	BackSnapshot = MoveTemp(PublishedSnapshot);
+	PublishedSnapshot = MoveTemp(Snapshot);
+}
+
+UAuraSpatialHashSubsystem::FSnapshotPtr UAuraSpatialHashSubsystem::GetSnapshot() const
+{
+	FScopeLock Lock(&SnapshotLock);
+	return PublishedSnapshot;
+}
@@ -6,7 +6,10 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "Player/AuraPlayerController.h"
+#include "AuraCosmetics.h"
+#if AURA_WITH_COSMETICS
 #include "UI/HUD/AuraHUD.h"
+#endif
 
 AAuraCharacter::AAuraCharacter()
 {
@@ -63,6 +66,7 @@ void AAuraCharacter::InitAbilityActorInfo()
 	
     
 
+#if AURA_WITH_COSMETICS
 	// クライアント環境では他プレイヤーのControllerはnull
 	if (AAuraPlayerController* AuraPlayerController = Cast<AAuraPlayerController>(GetController()))
 	{
@@ -71,6 +75,7 @@ void AAuraCharacter::InitAbilityActorInfo()
 			AuraHUD->InitOverlay(AuraPlayerController, AuraPlayerState, AbilitySystemComponent, AttributeSet);
 		} 
 	}
+#endif
 	InitializeDefaultAttributes();
 	
 }
@@ -4,8 +4,16 @@
 
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/Data/AuraAbilitySet.h"
+#include "AbilitySystem/Data/AuraCharacterClassInfo.h"
+#include "AbilitySystem/Data/AuraCombatData.h"
+#include "AbilitySystem/AuraAttributeSnapshotSubsystem.h"
+#include "AuraSpatialHashSubsystem.h"
+#include "Aura/Aura.h"
 #include "Components/CapsuleComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Initialize Default Attributes"), STAT_AuraInitializeDefaultAttributes, STATGROUP_Aura);
+
 // Sets default values
 AAuraCharacterBase::AAuraCharacterBase()
 {
@@ -30,6 +38,20 @@ void AAuraCharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UAuraSpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>())
+	{
+		SpatialHash->RegisterActor(this, EAuraSpatialCategory::Combatant);
+	}
+}
+
+void AAuraCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraSpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>())
+	{
+		SpatialHash->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAuraCharacterBase::InitAbilityActorInfo()
@@ -46,11 +68,78 @@ void AAuraCharacterBase::ApplyEffectToSelf(TSubclassOf<UGameplayEffect> Gameplay
 	GetAbilitySystemComponent()->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), GetAbilitySystemComponent());
 }
 
-void AAuraCharacterBase::InitializeDefaultAttributes() const
+void AAuraCharacterBase::InitializeDefaultAttributes()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraInitializeDefaultAttributes);
+
+	TSubclassOf<UGameplayEffect> PrimaryEffect;
+	TSubclassOf<UGameplayEffect> SecondaryEffect;
+	TSubclassOf<UGameplayEffect> VitalEffect;
+	GetDefaultAttributeEffects(PrimaryEffect, SecondaryEffect, VitalEffect);
+
+	// 設定されていないGEは飛ばす。ベイク済みの値（AuraCombatData.bin）があるGEは適用せずにBase値を設定する
+	auto ApplyIfSet = [this](const TSubclassOf<UGameplayEffect>& EffectClass)
+	{
+		if (EffectClass && !FAuraCombatData::Get().ApplyAttributeDefaults(EffectClass, 1, GetAbilitySystemComponent()))
+		{
+			ApplyEffectToSelf(EffectClass, 1.f);
+		}
+	};
+
+	// MMCはレベルを参照するのでキーに含める
+	FAuraAttributeSnapshotKey SnapshotKey;
+	SnapshotKey.PrimaryEffect = PrimaryEffect.Get();
+	SnapshotKey.SecondaryEffect = SecondaryEffect.Get();
+	SnapshotKey.VitalEffect = VitalEffect.Get();
+	SnapshotKey.Level = GetPlayerLevel();
+
+	UAuraAttributeSnapshotSubsystem* Snapshots = UAuraAttributeSnapshotSubsystem::IsEnabled() ? GetWorld()->GetSubsystem<UAuraAttributeSnapshotSubsystem>() : nullptr;
+	if (Snapshots)
+	{
+		if (const FAuraAttributeSnapshot* Snapshot = Snapshots->FindSnapshot(SnapshotKey))
+		{
+			Snapshots->ApplySnapshot(*Snapshot, SnapshotKey, GetAbilitySystemComponent(), [&ApplyIfSet, &SecondaryEffect]() { ApplyIfSet(SecondaryEffect); });
+			return;
+		}
+	}
+
+	ApplyIfSet(PrimaryEffect);
+	ApplyIfSet(SecondaryEffect);
+	ApplyIfSet(VitalEffect);
+
+	if (Snapshots)
+	{
+		Snapshots->CaptureSnapshot(SnapshotKey, GetAbilitySystemComponent());
+	}
+}
+
+void AAuraCharacterBase::ResetVitalAttributes() const
+{
+	TSubclassOf<UGameplayEffect> PrimaryEffect;
+	TSubclassOf<UGameplayEffect> SecondaryEffect;
+	TSubclassOf<UGameplayEffect> VitalEffect;
+	GetDefaultAttributeEffects(PrimaryEffect, SecondaryEffect, VitalEffect);
+
+	if (VitalEffect)
+	{
+		ApplyEffectToSelf(VitalEffect, 1.f);
+	}
+}
+
+void AAuraCharacterBase::GetDefaultAttributeEffects(TSubclassOf<UGameplayEffect>& OutPrimary, TSubclassOf<UGameplayEffect>& OutSecondary, TSubclassOf<UGameplayEffect>& OutVital) const
 {
-	ApplyEffectToSelf(DefaultPrimaryAttributes,1.f);
-	ApplyEffectToSelf(DefaultSecondaryAttributes,1.f);
-	ApplyEffectToSelf(DefaultVitalAttributes,1.f);
+	if (CharacterClassInfo)
+	{
+		// Startupバンドルで先読みされていなければここで同期読み込みになる
+		OutPrimary = CharacterClassInfo->PrimaryAttributes.LoadSynchronous();
+		OutSecondary = CharacterClassInfo->SecondaryAttributes.LoadSynchronous();
+		OutVital = CharacterClassInfo->VitalAttributes.LoadSynchronous();
+		return;
+	}
+
+	OutPrimary = DefaultPrimaryAttributes;
+	OutSecondary = DefaultSecondaryAttributes;
+	OutVital = DefaultVitalAttributes;
 }
 
 void AAuraCharacterBase::AddCharacterAbilities()
@@ -59,7 +148,13 @@ void AAuraCharacterBase::AddCharacterAbilities()
 	UAuraAbilitySystemComponent* AuraASC = CastChecked<UAuraAbilitySystemComponent>(AbilitySystemComponent);
 	if (!HasAuthority()) return;
 
-	AuraASC->AddCharacterAbilities(StartupAbilities);
+	const UAuraAbilitySet* ClassAbilitySet = CharacterClassInfo ? CharacterClassInfo->AbilitySet.LoadSynchronous() : nullptr;
+	AuraASC->GiveAbilitySet(ClassAbilitySet ? ClassAbilitySet : AbilitySet.Get());
+
+	if (!StartupAbilities.IsEmpty())
+	{
+		AuraASC->AddCharacterAbilities(StartupAbilities);
+	}
 	
 }
 
@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/AuraCrowdMovementSubsystem.h"
+#include "Characters/AuraEnemy.h"
+#include "Characters/AuraFlowFieldSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "NavigationSystem.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Movement"), STAT_AuraCrowdMovement, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Members"), STAT_AuraCrowdMembers, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Nav Projections"), STAT_AuraCrowdNavProjections, STATGROUP_Aura);
+
+static TAutoConsoleVariable<float> CVarAuraCrowdSeparationRadius(
+	TEXT("Aura.Crowd.SeparationRadius"),
+	120.f,
+	TEXT("Distance within which crowd members push each other apart."));
+
+static TAutoConsoleVariable<float> CVarAuraCrowdSeparationStrength(
+	TEXT("Aura.Crowd.SeparationStrength"),
+	1.f,
+	TEXT("Separation force relative to the member's max walk speed."));
+
+static TAutoConsoleVariable<int32> CVarAuraCrowdNavProjectionStride(
+	TEXT("Aura.Crowd.NavProjectionStride"),
+	4,
+	TEXT("Each crowd member is projected onto the navmesh every N frames. Frames in between keep the last height."));
+
+static TAutoConsoleVariable<float> CVarAuraCrowdNetSendRate(
+	TEXT("Aura.Crowd.NetSendRate"),
+	10.f,
+	TEXT("Times per second crowd members send their compressed location and yaw."));
+
+bool FAuraCrowdNetState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// 1cm精度、1軸24bitまで（FVector_NetQuantizeと同じ形式）
+	bOutSuccess = SerializePackedVector<1, 24>(Location, Ar);
+	Ar << Yaw;
+	Ar << TeleportCount;
+	return true;
+}
+
+float UAuraCrowdMovementSubsystem::GetNetSendRate()
+{
+	return FMath::Max(1.f, CVarAuraCrowdNetSendRate.GetValueOnGameThread());
+}
+
+bool UAuraCrowdMovementSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UAuraCrowdMovementSubsystem::Deinitialize()
+{
+	Members.Empty();
+	Velocities.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UAuraCrowdMovementSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraCrowdMovementSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraCrowdMovementSubsystem::RegisterMember(AAuraEnemy* Enemy)
+{
+	if (!Enemy || Members.Contains(Enemy)) return;
+
+	Members.Add(Enemy);
+	Velocities.Add(FVector::ZeroVector);
+}
+
+void UAuraCrowdMovementSubsystem::UnregisterMember(AAuraEnemy* Enemy)
+{
+	const int32 Index = Members.Find(Enemy);
+	if (Index == INDEX_NONE) return;
+
+	Members.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+}
+
+void UAuraCrowdMovementSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SET_DWORD_STAT(STAT_AuraCrowdMembers, Members.Num());
+	if (Members.IsEmpty() || DeltaTime <= 0.f) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AuraCrowdMovement);
+	++FrameCounter;
+
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		InterpolateMembers(DeltaTime);
+		return;
+	}
+
+	SimulateMembers(DeltaTime);
+
+	TimeSinceSend += DeltaTime;
+	if (TimeSinceSend >= 1.f / GetNetSendRate())
+	{
+		TimeSinceSend = 0.f;
+		SendMemberStates();
+	}
+}
+
+void UAuraCrowdMovementSubsystem::SimulateMembers(float DeltaTime)
+{
+	const UWorld* World = GetWorld();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const UAuraFlowFieldSubsystem* FlowField = World->GetSubsystem<UAuraFlowFieldSubsystem>();
+
+	// 追いかける対象（全プレイヤーのポーン）
+	TargetLocations.Reset();
+	if (const AGameStateBase* GameState = World->GetGameState())
+	{
+		for (const APlayerState* PlayerState : GameState->PlayerArray)
+		{
+			if (const APawn* Pawn = PlayerState ? PlayerState->GetPawn() : nullptr)
+			{
+				TargetLocations.Add(Pawn->GetActorLocation());
+			}
+		}
+	}
+
+	// 1. 位置を集めてグリッドに登録する（分離力は更新前の位置で計算するので処理順に依存しない）
+	const float SeparationRadius = FMath::Max(1.f, CVarAuraCrowdSeparationRadius.GetValueOnGameThread());
+	const float SeparationStrength = CVarAuraCrowdSeparationStrength.GetValueOnGameThread();
+	const int32 ProjectionStride = FMath::Max(1, CVarAuraCrowdNavProjectionStride.GetValueOnGameThread());
+
+	Locations.SetNumUninitialized(Members.Num(), false);
+	NewLocations.SetNumUninitialized(Members.Num(), false);
+	// 空のセルが溜まりすぎたら作り直す
+	if (Grid.Num() > Members.Num() * 4)
+	{
+		Grid.Reset();
+	}
+	for (TPair<FIntPoint, TArray<int32, TInlineAllocator<8>>>& Cell : Grid)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (int32 Index = 0; Index < Members.Num(); ++Index)
+	{
+		const AAuraEnemy* Enemy = Members[Index];
+		Locations[Index] = Enemy->GetActorLocation();
+		if (Enemy->bInPool) continue;
+
+		const FIntPoint CellKey(FMath::FloorToInt32(Locations[Index].X / SeparationRadius), FMath::FloorToInt32(Locations[Index].Y / SeparationRadius));
+		Grid.FindOrAdd(CellKey).Add(Index);
+	}
+
+	// 2. 新しい位置を計算する
+	int32 NumProjections = 0;
+	for (int32 Index = 0; Index < Members.Num(); ++Index)
+	{
+		AAuraEnemy* Enemy = Members[Index];
+		const FVector& Location = Locations[Index];
+		NewLocations[Index] = Location;
+		if (Enemy->bInPool) continue;
+
+		const float MaxSpeed = Enemy->GetCharacterMovement()->MaxWalkSpeed;
+
+		FVector DesiredVelocity = FVector::ZeroVector;
+		float BestDistSquared = MAX_flt;
+		FVector ToTarget = FVector::ZeroVector;
+		for (const FVector& Target : TargetLocations)
+		{
+			const FVector Delta = FVector(Target.X - Location.X, Target.Y - Location.Y, 0.f);
+			if (Delta.SizeSquared() < BestDistSquared)
+			{
+				BestDistSquared = Delta.SizeSquared();
+				ToTarget = Delta;
+			}
+		}
+		const float TargetDistance = FMath::Sqrt(BestDistSquared);
+		if (!TargetLocations.IsEmpty() && TargetDistance > Enemy->CrowdAcceptanceRadius)
+		{
+			// フローフィールドの範囲内なら障害物を回り込む方向、範囲外なら直進
+			FVector FlowDirection;
+			const bool bHasFlow = FlowField && FlowField->SampleDirection(Location, FlowDirection);
+			DesiredVelocity = (bHasFlow ? FlowDirection : ToTarget / TargetDistance) * MaxSpeed;
+		}
+
+		FVector Separation = FVector::ZeroVector;
+		const FIntPoint CellKey(FMath::FloorToInt32(Location.X / SeparationRadius), FMath::FloorToInt32(Location.Y / SeparationRadius));
+		for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+		{
+			for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+			{
+				const TArray<int32, TInlineAllocator<8>>* Cell = Grid.Find(CellKey + FIntPoint(OffsetX, OffsetY));
+				if (!Cell) continue;
+
+				for (const int32 OtherIndex : *Cell)
+				{
+					if (OtherIndex == Index) continue;
+
+					const FVector Away(Location.X - Locations[OtherIndex].X, Location.Y - Locations[OtherIndex].Y, 0.f);
+					const float Distance = Away.Size();
+					if (Distance >= SeparationRadius) continue;
+
+					// 完全に重なっている場合はインデックスで方向を決める
+					const FVector Direction = Distance > KINDA_SMALL_NUMBER ? Away / Distance : FVector(Index < OtherIndex ? 1.f : -1.f, 0.f, 0.f);
+					Separation += Direction * (1.f - Distance / SeparationRadius);
+				}
+			}
+		}
+
+		const FVector TargetVelocity = (DesiredVelocity + Separation * MaxSpeed * SeparationStrength).GetClampedToMaxSize2D(MaxSpeed);
+		Velocities[Index] = FMath::VInterpTo(Velocities[Index], TargetVelocity, DeltaTime, 8.f);
+
+		FVector NewLocation = Location + Velocities[Index] * DeltaTime;
+		if (NavSys && (FrameCounter + Index) % ProjectionStride == 0)
+		{
+			++NumProjections;
+			const float HalfHeight = Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+			FNavLocation NavLocation;
+			if (NavSys->ProjectPointToNavigation(NewLocation, NavLocation, FVector(50.f, 50.f, HalfHeight + 100.f)))
+			{
+				NewLocation = NavLocation.Location + FVector(0.f, 0.f, HalfHeight);
+			}
+			else
+			{
+				// ナビメッシュの外には出さない
+				NewLocation = Location;
+				Velocities[Index] = FVector::ZeroVector;
+			}
+		}
+		NewLocations[Index] = NewLocation;
+	}
+	SET_DWORD_STAT(STAT_AuraCrowdNavProjections, NumProjections);
+
+	// 3. まとめて反映する
+	for (int32 Index = 0; Index < Members.Num(); ++Index)
+	{
+		AAuraEnemy* Enemy = Members[Index];
+		if (Enemy->bInPool) continue;
+
+		FRotator Rotation = Enemy->GetActorRotation();
+		if (Velocities[Index].SizeSquared2D() > 1.f)
+		{
+			Rotation = FMath::RInterpTo(Rotation, FRotator(0.f, Velocities[Index].Rotation().Yaw, 0.f), DeltaTime, 10.f);
+		}
+
+		Enemy->SetActorLocationAndRotation(NewLocations[Index], Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+		// アニメーションBPが速度を参照できるように
+		Enemy->GetCharacterMovement()->Velocity = Velocities[Index];
+	}
+}
+
+void UAuraCrowdMovementSubsystem::SendMemberStates()
+{
+	for (AAuraEnemy* Enemy : Members)
+	{
+		if (Enemy->bInPool) continue;
+
+		FAuraCrowdNetState NetState = Enemy->CrowdNetState;
+		NetState.Location = Enemy->GetActorLocation().RoundToVector();
+		NetState.Yaw = FRotator::CompressAxisToShort(Enemy->GetActorRotation().Yaw);
+
+		// 止まっている敵は送らない
+		if (NetState.Location == Enemy->CrowdNetState.Location && NetState.Yaw == Enemy->CrowdNetState.Yaw) continue;
+
+		Enemy->CrowdNetState = NetState;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAuraEnemy, CrowdNetState, Enemy);
+	}
+}
+
+void UAuraCrowdMovementSubsystem::InterpolateMembers(float DeltaTime)
+{
+	const float InterpSpeed = GetNetSendRate();
+	for (AAuraEnemy* Enemy : Members)
+	{
+		if (Enemy->CrowdInterpAlpha >= 2.f) continue;
+
+		// 1を超えたら次の更新待ち。もう1周期届かなければ止まったとみなす
+		const bool bWasInterpolating = Enemy->CrowdInterpAlpha < 1.f;
+		Enemy->CrowdInterpAlpha = FMath::Min(2.f, Enemy->CrowdInterpAlpha + DeltaTime * InterpSpeed);
+		if (!bWasInterpolating)
+		{
+			if (Enemy->CrowdInterpAlpha >= 2.f)
+			{
+				Enemy->GetCharacterMovement()->Velocity = FVector::ZeroVector;
+			}
+			continue;
+		}
+
+		const FVector OldLocation = Enemy->GetActorLocation();
+		const FVector NewLocation = FMath::Lerp(Enemy->CrowdInterpFromLocation, Enemy->CrowdNetState.Location, FMath::Min(1.f, Enemy->CrowdInterpAlpha));
+		const FQuat NewRotation = FQuat::Slerp(Enemy->CrowdInterpFromRotation,
+			FRotator(0.f, FRotator::DecompressAxisFromShort(Enemy->CrowdNetState.Yaw), 0.f).Quaternion(), FMath::Min(1.f, Enemy->CrowdInterpAlpha));
+
+		Enemy->SetActorLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::TeleportPhysics);
+		Enemy->GetCharacterMovement()->Velocity = (NewLocation - OldLocation) / DeltaTime;
+	}
+}
@@ -2,14 +2,81 @@
 
 
 #include "Characters/AuraEnemy.h"
+#include "GameplayEffect.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAttributeSet.h"
 #include "Aura/Aura.h"
+#include "AuraCosmetics.h"
+#include "Characters/AuraEnemySpawnDirector.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SignificanceManager.h"
+#include "AuraSpatialHashSubsystem.h"
+#include "Net/AuraReplicationGraph.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Full Rate Enemies"), STAT_AuraFullRateEnemies, STATGROUP_Aura);
 
 void AAuraEnemy::BeginPlay()
 {
 	Super::BeginPlay();
-	InitAbilityActorInfo();
+
+	// ディレクターが管理する敵はフレーム予算内で初期化される
+	if (!bManagedBySpawnDirector)
+	{
+		InitializeEnemy();
+	}
+
+	if (bUseCrowdMovement)
+	{
+		// 位置はCrowdNetStateで送る
+		SetReplicateMovement(false);
+		NetUpdateFrequency = UAuraCrowdMovementSubsystem::GetNetSendRate();
+		// ReplicationGraphはクラスの頻度で登録するので、登録済みならこの敵の頻度を反映する（未登録なら登録時に反映される）
+		if (const UNetDriver* NetDriver = GetNetDriver())
+		{
+			if (UAuraReplicationGraph* ReplicationGraph = NetDriver->GetReplicationDriver<UAuraReplicationGraph>())
+			{
+				ReplicationGraph->SetActorNetUpdateFrequency(this, NetUpdateFrequency);
+			}
+		}
+		GetCharacterMovement()->SetComponentTickEnabled(false);
+		GetWorld()->GetSubsystem<UAuraCrowdMovementSubsystem>()->RegisterMember(this);
+	}
+
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->RegisterObject(this, UAuraSignificanceSubsystem::EnemyTag,
+			[this](USignificanceManager::FManagedObjectInfo*, const FTransform& Viewpoint)
+			{
+				return CalculateSignificance(Viewpoint);
+			},
+			USignificanceManager::EPostSignificanceType::Sequential,
+			[this](USignificanceManager::FManagedObjectInfo*, float, float Significance, bool bFinal)
+			{
+				if (bFinal) return;
+				ApplySignificanceBucket(SignificanceBuckets.Num() - FMath::RoundToInt32(Significance));
+			});
+	}
+}
+
+void AAuraEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraCrowdMovementSubsystem* CrowdMovement = bUseCrowdMovement ? GetWorld()->GetSubsystem<UAuraCrowdMovementSubsystem>() : nullptr)
+	{
+		CrowdMovement->UnregisterMember(this);
+	}
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(this);
+	}
+	if (CurrentSignificanceBucket == 0)
+	{
+		DEC_DWORD_STAT(STAT_AuraFullRateEnemies);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 AAuraEnemy::AAuraEnemy()
@@ -23,22 +90,54 @@ AAuraEnemy::AAuraEnemy()
 
 	AttributeSet = CreateDefaultSubobject<UAuraAttributeSet>("AttributeSet");
 
+	// 近距離: 毎フレーム / 中距離: 15Hz / 遠距離: 5Hz・武器のポーズ更新なし
+	SignificanceBuckets.Add({ 1500.f, 0.f, 0.f, true });
+	SignificanceBuckets.Add({ 4000.f, 1.f / 15.f, 1.f / 15.f, true });
+	SignificanceBuckets.Add({ 0.f, 0.2f, 0.2f, false });
+
+}
+
+void AAuraEnemy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 群衆移動の敵だけがダーティにする（プッシュモデル）
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraEnemy, CrowdNetState, Params);
+}
+
+void AAuraEnemy::OnRep_CrowdNetState(const FAuraCrowdNetState& OldCrowdNetState)
+{
+	if (CrowdNetState.TeleportCount != OldCrowdNetState.TeleportCount)
+	{
+		const FRotator Rotation(0.f, FRotator::DecompressAxisFromShort(CrowdNetState.Yaw), 0.f);
+		SetActorLocationAndRotation(CrowdNetState.Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+		CrowdInterpAlpha = 2.f;
+		return;
+	}
+
+	CrowdInterpFromLocation = GetActorLocation();
+	CrowdInterpFromRotation = GetActorQuat();
+	CrowdInterpAlpha = 0.f;
 }
 
 void AAuraEnemy::HighlightActor()
 {
-	
+#if AURA_WITH_COSMETICS
 	GetMesh()->SetRenderCustomDepth(true);
 	GetMesh()->SetCustomDepthStencilValue(CUSTOM_DEPTH_RED);
 	Weapon->SetRenderCustomDepth(true);
 	Weapon->SetCustomDepthStencilValue(CUSTOM_DEPTH_RED);
+#endif
 }
 
 void AAuraEnemy::UnHighlightActor()
 {
+#if AURA_WITH_COSMETICS
 	GetMesh()->SetRenderCustomDepth(false);
 	Weapon->SetRenderCustomDepth(false);
-
+#endif
 }
 
 int32 AAuraEnemy::GetPlayerLevel()
@@ -46,9 +145,159 @@ int32 AAuraEnemy::GetPlayerLevel()
 	return Level;
 }
 
+void AAuraEnemy::Die()
+{
+	if (!HasAuthority()) return;
+
+	if (!bManagedBySpawnDirector) return;
+
+	if (UAuraEnemySpawnDirector* SpawnDirector = GetWorld()->GetSubsystem<UAuraEnemySpawnDirector>())
+	{
+		SpawnDirector->ReleaseEnemy(this);
+	}
+}
+
+void AAuraEnemy::InitializeEnemy()
+{
+	if (bEnemyInitialized) return;
+
+	InitAbilityActorInfo();
+	bEnemyInitialized = true;
+}
+
+void AAuraEnemy::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	if (bEnemyInitialized)
+	{
+		// Primary/Secondaryは同じクラス・レベルなので変わらない
+		ResetVitalAttributes();
+	}
+	else
+	{
+		InitializeEnemy();
+	}
+
+	bInPool = false;
+	if (UAuraSpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>())
+	{
+		SpatialHash->RegisterActor(this, EAuraSpatialCategory::Combatant);
+	}
+	if (bUseCrowdMovement)
+	{
+		// クライアントは補間せずに出現位置へ移動する
+		CrowdNetState.Location = SpawnTransform.GetLocation().RoundToVector();
+		CrowdNetState.Yaw = FRotator::CompressAxisToShort(SpawnTransform.Rotator().Yaw);
+		++CrowdNetState.TeleportCount;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AAuraEnemy, CrowdNetState, this);
+	}
+	SetNetDormancy(DORM_Awake);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	if (!bUseCrowdMovement)
+	{
+		GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+	}
+	ForceNetUpdate();
+}
+
+float AAuraEnemy::CalculateSignificance(const FTransform& Viewpoint) const
+{
+	const int32 NumBuckets = SignificanceBuckets.Num();
+	if (NumBuckets == 0 || bInPool) return 0.f;
+
+	const float Distance = FVector::Dist(GetActorLocation(), Viewpoint.GetLocation());
+	int32 BucketIndex = 0;
+	while (BucketIndex < NumBuckets - 1 && Distance > SignificanceBuckets[BucketIndex].MaxDistance)
+	{
+		++BucketIndex;
+	}
+
+	// 専用サーバーでは描画しないので距離だけで決める
+	if (GetNetMode() != NM_DedicatedServer && !WasRecentlyRendered(0.5f))
+	{
+		BucketIndex = FMath::Min(BucketIndex + 1, NumBuckets - 1);
+	}
+
+	// 重要度は大きいほど近い（視点ごとの最大値が使われる）
+	return static_cast<float>(NumBuckets - BucketIndex);
+}
+
+void AAuraEnemy::ApplySignificanceBucket(int32 BucketIndex)
+{
+	BucketIndex = FMath::Clamp(BucketIndex, 0, SignificanceBuckets.Num() - 1);
+	if (!SignificanceBuckets.IsValidIndex(BucketIndex) || BucketIndex == CurrentSignificanceBucket) return;
+
+	if (CurrentSignificanceBucket == 0) DEC_DWORD_STAT(STAT_AuraFullRateEnemies);
+	if (BucketIndex == 0) INC_DWORD_STAT(STAT_AuraFullRateEnemies);
+	CurrentSignificanceBucket = BucketIndex;
+
+	const FAuraSignificanceBucket& Bucket = SignificanceBuckets[BucketIndex];
+	GetMesh()->SetComponentTickInterval(Bucket.MeshTickInterval);
+	GetCharacterMovement()->SetComponentTickInterval(Bucket.MovementTickInterval);
+
+	// 武器はソケットに付いているだけなので、止めても位置は手に追従する
+	Weapon->bNoSkeletonUpdate = !Bucket.bUpdateWeaponPose;
+	Weapon->SetComponentTickEnabled(Bucket.bUpdateWeaponPose);
+}
+
+void AAuraEnemy::DeactivateToPool()
+{
+	bInPool = true;
+	if (UAuraSpatialHashSubsystem* SpatialHash = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>())
+	{
+		SpatialHash->UnregisterActor(this);
+	}
+	UnHighlightActor();
+	AbilitySystemComponent->CancelAllAbilities();
+	ClearCombatState();
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+
+	// 非表示がクライアントに送られてからチャンネルが閉じる
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AAuraEnemy::ClearCombatState()
+{
+	TSubclassOf<UGameplayEffect> PrimaryEffect;
+	TSubclassOf<UGameplayEffect> SecondaryEffect;
+	TSubclassOf<UGameplayEffect> VitalEffect;
+	GetDefaultAttributeEffects(PrimaryEffect, SecondaryEffect, VitalEffect);
+
+	// 初期化で付けたSecondary（Infinite）以外のGE（バフ・デバフ・クールダウン）を外す
+	FGameplayEffectQuery Query;
+	Query.CustomMatchDelegate.BindLambda([SecondaryEffect](const FActiveGameplayEffect& Effect)
+	{
+		return !SecondaryEffect || !Effect.Spec.Def || Effect.Spec.Def->GetClass() != SecondaryEffect;
+	});
+	AbilitySystemComponent->RemoveActiveEffects(Query);
+
+	// 残っているタグのうち、Secondaryが付けるもの以外はルーズタグなので外す
+	const FGameplayTagContainer SecondaryGrantedTags = SecondaryEffect ? SecondaryEffect.GetDefaultObject()->GetGrantedTags() : FGameplayTagContainer();
+	FGameplayTagContainer OwnedTags;
+	AbilitySystemComponent->GetOwnedGameplayTags(OwnedTags);
+	for (const FGameplayTag& Tag : OwnedTags)
+	{
+		if (!SecondaryGrantedTags.HasTagExact(Tag))
+		{
+			AbilitySystemComponent->SetLooseGameplayTagCount(Tag, 0);
+		}
+	}
+}
 
 void AAuraEnemy::InitAbilityActorInfo()
 {
 	AbilitySystemComponent->InitAbilityActorInfo(this, this);
 	Cast<UAuraAbilitySystemComponent>(AbilitySystemComponent)->AbilityActorInfoSet();
+
+	// 属性はレプリケートされるのでサーバーでのみ初期化する
+	if (HasAuthority())
+	{
+		InitializeDefaultAttributes();
+	}
 }
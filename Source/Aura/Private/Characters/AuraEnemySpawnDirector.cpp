@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/AuraEnemySpawnDirector.h"
+#include "Characters/AuraEnemy.h"
+#include "Engine/World.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Spawn Director Tick"), STAT_AuraEnemySpawnDirectorTick, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Activated"), STAT_AuraEnemiesActivated, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Spawns Queued"), STAT_AuraEnemySpawnsQueued, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Spawns Avoided"), STAT_AuraEnemySpawnsAvoided, STATGROUP_Aura);
+
+static TAutoConsoleVariable<float> CVarAuraSpawnDirectorBudgetMs(
+	TEXT("Aura.SpawnDirector.BudgetMs"),
+	2.f,
+	TEXT("Milliseconds per frame the enemy spawn director may spend activating and prewarming enemies. At least one enemy is processed per frame."));
+
+bool UAuraEnemySpawnDirector::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UAuraEnemySpawnDirector::Deinitialize()
+{
+	Pools.Empty();
+	PendingReleases.Empty();
+	PendingSpawns.Empty();
+	NextSpawnIndex = 0;
+
+	Super::Deinitialize();
+}
+
+TStatId UAuraEnemySpawnDirector::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraEnemySpawnDirector, STATGROUP_Tickables);
+}
+
+void UAuraEnemySpawnDirector::PrewarmEnemies(TSubclassOf<AAuraEnemy> EnemyClass, int32 Count)
+{
+	if (!EnemyClass || GetWorld()->GetNetMode() == NM_Client) return;
+
+	FAuraEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+	Pool.NumToPrewarm = FMath::Max(Pool.NumToPrewarm, FMath::Min(Count, MaxPooledEnemiesPerClass) - Pool.FreeEnemies.Num());
+}
+
+void UAuraEnemySpawnDirector::QueueSpawn(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	if (!EnemyClass || GetWorld()->GetNetMode() == NM_Client) return;
+
+	PendingSpawns.Add({ EnemyClass, SpawnTransform });
+}
+
+void UAuraEnemySpawnDirector::ReleaseEnemy(AAuraEnemy* Enemy)
+{
+	if (!IsValid(Enemy) || !Enemy->bManagedBySpawnDirector || Enemy->bInPool) return;
+
+	PendingReleases.AddUnique(Enemy);
+}
+
+int32 UAuraEnemySpawnDirector::GetNumPooledEnemies(TSubclassOf<AAuraEnemy> EnemyClass) const
+{
+	const FAuraEnemyPool* Pool = Pools.Find(EnemyClass);
+	return Pool ? Pool->FreeEnemies.Num() : 0;
+}
+
+bool UAuraEnemySpawnDirector::HasPendingWork() const
+{
+	if (!PendingReleases.IsEmpty() || NextSpawnIndex < PendingSpawns.Num()) return true;
+
+	for (const TPair<TSubclassOf<AAuraEnemy>, FAuraEnemyPool>& Pair : Pools)
+	{
+		if (Pair.Value.NumToPrewarm > 0) return true;
+	}
+	return false;
+}
+
+void UAuraEnemySpawnDirector::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SET_DWORD_STAT(STAT_AuraEnemySpawnsQueued, GetNumQueuedSpawns());
+	if (!HasPendingWork()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AuraEnemySpawnDirectorTick);
+
+	// 非アクティブ化は軽いので予算に関係なくすべて行う
+	for (AAuraEnemy* Enemy : PendingReleases)
+	{
+		DeactivateEnemy(Enemy);
+	}
+	PendingReleases.Reset();
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = FMath::Max(0.f, CVarAuraSpawnDirectorBudgetMs.GetValueOnGameThread()) / 1000.0;
+	bool bProcessedAny = false;
+	auto HasBudget = [&]()
+	{
+		// 予算が小さすぎても毎フレーム最低1体は進める
+		return !bProcessedAny || FPlatformTime::Seconds() - StartTime < BudgetSeconds;
+	};
+
+	while (NextSpawnIndex < PendingSpawns.Num() && HasBudget())
+	{
+		ActivateEnemy(PendingSpawns[NextSpawnIndex++]);
+		bProcessedAny = true;
+		INC_DWORD_STAT(STAT_AuraEnemiesActivated);
+	}
+
+	if (NextSpawnIndex >= PendingSpawns.Num())
+	{
+		PendingSpawns.Reset();
+		NextSpawnIndex = 0;
+	}
+
+	// 出現待ちが無いフレームの残り予算で事前生成する
+	for (TPair<TSubclassOf<AAuraEnemy>, FAuraEnemyPool>& Pair : Pools)
+	{
+		FAuraEnemyPool& Pool = Pair.Value;
+		while (Pool.NumToPrewarm > 0 && PendingSpawns.IsEmpty() && HasBudget())
+		{
+			--Pool.NumToPrewarm;
+			bProcessedAny = true;
+			if (AAuraEnemy* Enemy = SpawnPooledEnemy(Pair.Key, FTransform::Identity))
+			{
+				Enemy->InitializeEnemy();
+				Enemy->DeactivateToPool();
+				Pool.FreeEnemies.Add(Enemy);
+			}
+		}
+	}
+}
+
+AAuraEnemy* UAuraEnemySpawnDirector::SpawnPooledEnemy(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+	AAuraEnemy* Enemy = GetWorld()->SpawnActorDeferred<AAuraEnemy>(EnemyClass, SpawnTransform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Enemy) return nullptr;
+
+	Enemy->bManagedBySpawnDirector = true;
+	Enemy->FinishSpawning(SpawnTransform);
+	return Enemy;
+}
+
+void UAuraEnemySpawnDirector::ActivateEnemy(const FAuraEnemySpawnRequest& Request)
+{
+	FAuraEnemyPool& Pool = Pools.FindOrAdd(Request.EnemyClass);
+
+	AAuraEnemy* Enemy = nullptr;
+	while (!Enemy && Pool.FreeEnemies.Num() > 0)
+	{
+		Enemy = Pool.FreeEnemies.Pop(false);
+		if (!IsValid(Enemy))
+		{
+			Enemy = nullptr;
+			continue;
+		}
+		INC_DWORD_STAT(STAT_AuraEnemySpawnsAvoided);
+	}
+
+	if (!Enemy)
+	{
+		Enemy = SpawnPooledEnemy(Request.EnemyClass, Request.Transform);
+	}
+
+	if (Enemy)
+	{
+		Enemy->ActivateFromPool(Request.Transform);
+	}
+}
+
+void UAuraEnemySpawnDirector::DeactivateEnemy(AAuraEnemy* Enemy)
+{
+	if (!IsValid(Enemy) || Enemy->bInPool) return;
+
+	FAuraEnemyPool& Pool = Pools.FindOrAdd(Enemy->GetClass());
+	if (Pool.FreeEnemies.Num() >= MaxPooledEnemiesPerClass)
+	{
+		Enemy->Destroy();
+		return;
+	}
+
+	Enemy->DeactivateToPool();
+	Pool.FreeEnemies.Add(Enemy);
+}
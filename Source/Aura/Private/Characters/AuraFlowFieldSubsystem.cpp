@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/AuraFlowFieldSubsystem.h"
+#include "Characters/AuraCrowdMovementSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "NavigationSystem.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flow Field Tick"), STAT_AuraFlowFieldTick, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("Flow Field Build (worker)"), STAT_AuraFlowFieldBuild, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Flow Field Cells Sampled"), STAT_AuraFlowFieldCellsSampled, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Flow Field Builds"), STAT_AuraFlowFieldBuilds, STATGROUP_Aura);
+
+static TAutoConsoleVariable<int32> CVarAuraFlowFieldSampleBudget(
+	TEXT("Aura.FlowField.SampleBudget"),
+	512,
+	TEXT("Navmesh projections per frame used to fill the flow field cell cache."));
+
+namespace AuraFlowField
+{
+	// 8方向（先頭4つが上下左右）
+	const FIntPoint NeighborOffsets[8] = {
+		{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+		{ 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+	};
+
+	// ワーカースレッドで実行する。Cellsはフィールドと同じ並び（Size * Size）
+	TSharedPtr<const FAuraFlowField, ESPMode::ThreadSafe> Build(const FIntPoint& OriginCell, int32 Size, float CellSize,
+		const FIntPoint& TargetCell, const TArray<FAuraFlowFieldCell>& Cells, float MaxStepHeight)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AuraFlowFieldBuild);
+
+		TSharedPtr<FAuraFlowField, ESPMode::ThreadSafe> Field = MakeShared<FAuraFlowField, ESPMode::ThreadSafe>();
+		Field->OriginCell = OriginCell;
+		Field->Size = Size;
+		Field->CellSize = CellSize;
+		Field->TargetCell = TargetCell;
+		Field->Distances.Init(FAuraFlowField::Unreachable, Size * Size);
+		Field->Directions.Init(FAuraFlowField::NoDirection, Size * Size);
+
+		auto IsInside = [Size](const FIntPoint& Local) { return Local.X >= 0 && Local.Y >= 0 && Local.X < Size && Local.Y < Size; };
+		auto ToIndex = [Size](const FIntPoint& Local) { return Local.Y * Size + Local.X; };
+		auto CanStep = [&](int32 FromIndex, int32 ToIndex)
+		{
+			return Cells[ToIndex].bWalkable && FMath::Abs(Cells[ToIndex].Height - Cells[FromIndex].Height) < MaxStepHeight;
+		};
+
+		const FIntPoint TargetLocal = TargetCell - OriginCell;
+		if (!IsInside(TargetLocal) || !Cells[ToIndex(TargetLocal)].bWalkable)
+		{
+			return Field;
+		}
+
+		// 1. ターゲットから上下左右に幅優先探索
+		TArray<FIntPoint> Frontier;
+		Frontier.Reserve(Size * Size);
+		Frontier.Add(TargetLocal);
+		Field->Distances[ToIndex(TargetLocal)] = 0;
+		for (int32 Head = 0; Head < Frontier.Num(); ++Head)
+		{
+			const FIntPoint Local = Frontier[Head];
+			const int32 Index = ToIndex(Local);
+			for (int32 Neighbor = 0; Neighbor < 4; ++Neighbor)
+			{
+				const FIntPoint NextLocal = Local + NeighborOffsets[Neighbor];
+				if (!IsInside(NextLocal)) continue;
+
+				const int32 NextIndex = ToIndex(NextLocal);
+				if (Field->Distances[NextIndex] != FAuraFlowField::Unreachable || !CanStep(Index, NextIndex)) continue;
+
+				Field->Distances[NextIndex] = Field->Distances[Index] + 1;
+				Frontier.Add(NextLocal);
+			}
+		}
+
+		// 2. 各セルで距離が最も小さい隣接セルを向く（斜めは角を削らないよう両隣が通れる場合のみ）
+		for (const FIntPoint& Local : Frontier)
+		{
+			const int32 Index = ToIndex(Local);
+			uint16 BestDistance = Field->Distances[Index];
+			for (int32 Neighbor = 0; Neighbor < 8; ++Neighbor)
+			{
+				const FIntPoint Offset = NeighborOffsets[Neighbor];
+				const FIntPoint NextLocal = Local + Offset;
+				if (!IsInside(NextLocal)) continue;
+
+				const int32 NextIndex = ToIndex(NextLocal);
+				if (Field->Distances[NextIndex] >= BestDistance || !CanStep(Index, NextIndex)) continue;
+
+				if (Neighbor >= 4)
+				{
+					const FIntPoint SideX(Local.X + Offset.X, Local.Y);
+					const FIntPoint SideY(Local.X, Local.Y + Offset.Y);
+					if (!CanStep(Index, ToIndex(SideX)) || !CanStep(Index, ToIndex(SideY))) continue;
+				}
+
+				BestDistance = Field->Distances[NextIndex];
+				Field->Directions[Index] = static_cast<uint8>(Neighbor);
+			}
+		}
+
+		return Field;
+	}
+}
+
+bool FAuraFlowField::Sample(const FVector& Location, FVector& OutDirection, int32& OutDistance) const
+{
+	const FIntPoint Local = FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize)) - OriginCell;
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= Size || Local.Y >= Size) return false;
+
+	const int32 Index = Local.Y * Size + Local.X;
+	if (Directions[Index] == NoDirection) return false;
+
+	const FIntPoint Offset = AuraFlowField::NeighborOffsets[Directions[Index]];
+	OutDirection = FVector(Offset.X, Offset.Y, 0.f).GetSafeNormal();
+	OutDistance = Distances[Index];
+	return true;
+}
+
+bool UAuraFlowFieldSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UAuraFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &UAuraFlowFieldSubsystem::OnNavigationGenerationFinished);
+	}
+}
+
+void UAuraFlowFieldSubsystem::Deinitialize()
+{
+	// 作成中のタスクはキャプチャしたコピーだけを使うので、待たずに結果を捨てる
+	PlayerFields.Empty();
+	CellCache.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UAuraFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraFlowFieldSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	CellCache.Reset();
+	for (TPair<TWeakObjectPtr<const APlayerState>, FPlayerField>& Pair : PlayerFields)
+	{
+		Pair.Value.BuiltForCell = FIntPoint(MAX_int32, MAX_int32);
+	}
+}
+
+FIntPoint UAuraFlowFieldSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UAuraFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World->GetGameState();
+	if (World->GetNetMode() == NM_Client || !GameState) return;
+
+	// フィールドを使うのは群衆移動の敵だけなので、いなければ更新しない（再開時にプレイヤーが別のセルにいれば作り直される）
+	const UAuraCrowdMovementSubsystem* CrowdMovement = World->GetSubsystem<UAuraCrowdMovementSubsystem>();
+	if (!CrowdMovement || CrowdMovement->GetNumMembers() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AuraFlowFieldTick);
+
+	// いなくなったプレイヤーのフィールドを捨てる
+	for (auto It = PlayerFields.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// プレイヤーが歩き回ってキャッシュが大きくなりすぎたら作り直す
+	const int32 WindowCells = FMath::Square(HalfExtentCells * 2 + 1);
+	if (CellCache.Num() > WindowCells * FMath::Max(4, PlayerFields.Num() * 2))
+	{
+		CellCache.Reset();
+	}
+
+	int32 SampleBudget = FMath::Max(0, CVarAuraFlowFieldSampleBudget.GetValueOnGameThread());
+	const int32 InitialBudget = SampleBudget;
+	for (const APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		if (const APawn* Pawn = PlayerState ? PlayerState->GetPawn() : nullptr)
+		{
+			UpdatePlayerField(Pawn->GetActorLocation(), PlayerFields.FindOrAdd(PlayerState), SampleBudget);
+		}
+	}
+	SET_DWORD_STAT(STAT_AuraFlowFieldCellsSampled, InitialBudget - SampleBudget);
+}
+
+void UAuraFlowFieldSubsystem::UpdatePlayerField(const FVector& TargetLocation, FPlayerField& Field, int32& SampleBudget)
+{
+	// 完成したら差し替える（ダブルバッファ）
+	if (Field.bTaskInFlight)
+	{
+		if (!Field.PendingTask.IsCompleted()) return;
+
+		Field.Current = Field.PendingTask.GetResult();
+		Field.PendingTask = {};
+		Field.bTaskInFlight = false;
+		INC_DWORD_STAT(STAT_AuraFlowFieldBuilds);
+	}
+
+	const FIntPoint TargetCell = ToCell(TargetLocation);
+	if (TargetCell == Field.BuiltForCell) return;
+
+	const int32 Size = HalfExtentCells * 2 + 1;
+	const FIntPoint OriginCell = TargetCell - FIntPoint(HalfExtentCells, HalfExtentCells);
+
+	// 範囲内のセルがすべてキャッシュされるまで待つ（数フレームに分けてサンプリング）
+	if (!SampleWindow(OriginCell, Size, TargetLocation.Z, SampleBudget)) return;
+
+	TArray<FAuraFlowFieldCell> Cells;
+	Cells.SetNumUninitialized(Size * Size);
+	for (int32 Y = 0; Y < Size; ++Y)
+	{
+		for (int32 X = 0; X < Size; ++X)
+		{
+			Cells[Y * Size + X] = CellCache.FindChecked(OriginCell + FIntPoint(X, Y));
+		}
+	}
+
+	Field.BuiltForCell = TargetCell;
+	Field.bTaskInFlight = true;
+	Field.PendingTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[OriginCell, Size, CellSize = CellSize, TargetCell, Cells = MoveTemp(Cells), MaxStepHeight = MaxStepHeight]()
+		{
+			return AuraFlowField::Build(OriginCell, Size, CellSize, TargetCell, Cells, MaxStepHeight);
+		});
+}
+
+bool UAuraFlowFieldSubsystem::SampleWindow(const FIntPoint& OriginCell, int32 Size, float ReferenceHeight, int32& SampleBudget)
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys) return false;
+
+	// クリック移動と同じデフォルトのナビデータ
+	const ANavigationData* NavData = NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
+	if (!NavData) return false;
+
+	bool bComplete = true;
+	const FVector QueryExtent(CellSize * 0.5f, CellSize * 0.5f, 500.f);
+	for (int32 Y = 0; Y < Size; ++Y)
+	{
+		for (int32 X = 0; X < Size; ++X)
+		{
+			const FIntPoint Cell = OriginCell + FIntPoint(X, Y);
+			if (CellCache.Contains(Cell)) continue;
+
+			if (SampleBudget <= 0)
+			{
+				bComplete = false;
+				continue;
+			}
+			--SampleBudget;
+
+			const FVector CellCenter((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, ReferenceHeight);
+			FNavLocation NavLocation;
+			FAuraFlowFieldCell& CachedCell = CellCache.Add(Cell);
+			CachedCell.bWalkable = NavSys->ProjectPointToNavigation(CellCenter, NavLocation, QueryExtent, NavData);
+			CachedCell.Height = CachedCell.bWalkable ? NavLocation.Location.Z : ReferenceHeight;
+		}
+	}
+	return bComplete;
+}
+
+bool UAuraFlowFieldSubsystem::SampleDirection(const FVector& Location, FVector& OutDirection) const
+{
+	int32 BestDistance = MAX_int32;
+	for (const TPair<TWeakObjectPtr<const APlayerState>, FPlayerField>& Pair : PlayerFields)
+	{
+		FVector Direction;
+		int32 Distance = 0;
+		if (Pair.Value.Current && Pair.Value.Current->Sample(Location, Direction, Distance) && Distance < BestDistance)
+		{
+			BestDistance = Distance;
+			OutDirection = Direction;
+		}
+	}
+	return BestDistance != MAX_int32;
+}
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/AuraSignificanceSubsystem.h"
+#include "SignificanceManager.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_AuraSignificanceUpdate, STATGROUP_Aura);
+
+static TAutoConsoleVariable<float> CVarAuraSignificanceUpdateInterval(
+	TEXT("Aura.Significance.UpdateInterval"),
+	0.25f,
+	TEXT("Seconds between significance updates for Aura enemies. 0 updates every frame."));
+
+const FName UAuraSignificanceSubsystem::EnemyTag(TEXT("AuraEnemy"));
+
+bool UAuraSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UAuraSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UAuraSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < CVarAuraSignificanceUpdateInterval.GetValueOnGameThread()) return;
+	TimeSinceUpdate = 0.f;
+
+	UWorld* World = GetWorld();
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(World);
+	const AGameStateBase* GameState = World->GetGameState();
+	if (!SignificanceManager || !GameState) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AuraSignificanceUpdate);
+
+	// サーバーもクライアントも、すべてのプレイヤーのポーンを視点とする（PlayerStateのPawnはレプリケートされる）
+	Viewpoints.Reset();
+	for (const APlayerState* PlayerState : GameState->PlayerArray)
+	{
+		if (const APawn* Pawn = PlayerState ? PlayerState->GetPawn() : nullptr)
+		{
+			Viewpoints.Add(Pawn->GetActorTransform());
+		}
+	}
+
+	SignificanceManager->Update(Viewpoints);
+}
@@ -2,15 +2,14 @@
 
 
 #include "Input/AuraInputConfig.h"
+#include "AuraGameplayTags.h"
 
 const UInputAction* UAuraInputConfig::FindAbilityInputActionForTag(const FGameplayTag InputTag, bool bLogNotFound) const
 {
-	for (const FAuraInputAction& Action : AbilityInputActions)
+	const EAuraInputSlot Slot = GetSlotForInputTag(InputTag);
+	if (const UInputAction* InputAction = FindAbilityInputActionForSlot(Slot))
 	{
-		if (Action.InputAction && Action.InputTag == InputTag)
-		{
-			return Action.InputAction;
-		}
+		return InputAction;
 	}
 
 	if (bLogNotFound)
@@ -20,3 +19,77 @@ const UInputAction* UAuraInputConfig::FindAbilityInputActionForTag(const FGamepl
 
 	return nullptr;
 }
+
+const UInputAction* UAuraInputConfig::FindAbilityInputActionForSlot(EAuraInputSlot Slot) const
+{
+	if (Slot == EAuraInputSlot::MAX) return nullptr;
+	return GetSlotInputActions()[static_cast<int32>(Slot)];
+}
+
+const TStaticArray<const UInputAction*, AuraInputSlotCount>& UAuraInputConfig::GetSlotInputActions() const
+{
+	if (!bInputSlotsCompiled)
+	{
+		CompileInputSlots();
+	}
+	return SlotInputActions;
+}
+
+EAuraInputSlot UAuraInputConfig::GetSlotForInputTag(const FGameplayTag& InputTag)
+{
+	for (int32 Index = 0; Index < AuraInputSlotCount; ++Index)
+	{
+		const EAuraInputSlot Slot = static_cast<EAuraInputSlot>(Index);
+		if (GetInputTagForSlot(Slot) == InputTag)
+		{
+			return Slot;
+		}
+	}
+	return EAuraInputSlot::MAX;
+}
+
+const FGameplayTag& UAuraInputConfig::GetInputTagForSlot(EAuraInputSlot Slot)
+{
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+
+	switch (Slot)
+	{
+	case EAuraInputSlot::LMB:	return GameplayTags.InputTag_LMB;
+	case EAuraInputSlot::RMB:	return GameplayTags.InputTag_RMB;
+	case EAuraInputSlot::Key1:	return GameplayTags.InputTag_1;
+	case EAuraInputSlot::Key2:	return GameplayTags.InputTag_2;
+	case EAuraInputSlot::Key3:	return GameplayTags.InputTag_3;
+	case EAuraInputSlot::Key4:	return GameplayTags.InputTag_4;
+	default:					return FGameplayTag::EmptyTag;
+	}
+}
+
+#if WITH_EDITOR
+void UAuraInputConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	bInputSlotsCompiled = false;
+}
+#endif
+
+void UAuraInputConfig::CompileInputSlots() const
+{
+	for (const UInputAction*& InputAction : SlotInputActions)
+	{
+		InputAction = nullptr;
+	}
+
+	for (const FAuraInputAction& Action : AbilityInputActions)
+	{
+		const EAuraInputSlot Slot = GetSlotForInputTag(Action.InputTag);
+		if (Action.InputAction && Slot != EAuraInputSlot::MAX)
+		{
+			SlotInputActions[static_cast<int32>(Slot)] = Action.InputAction;
+		}
+		else if (Action.InputAction)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("InputTag [%s] on InputConfig [%s] has no input slot."), *Action.InputTag.ToString(), *GetNameSafe(this));
+		}
+	}
+	bInputSlotsCompiled = true;
+}
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Net/AuraLoadTestSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+bool UAuraLoadTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && FParse::Param(FCommandLine::Get(), TEXT("AuraLoadTest")) && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UAuraLoadTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("AuraLoadTestDuration="), Duration);
+
+	// 実行ごとに別ファイル（run_loadtest.shが結果ディレクトリに集める）
+	CsvFilename = FPaths::Combine(FPaths::ProfilingDir(), TEXT("AuraLoadTest"), FString::Printf(TEXT("AuraLoadTest_%s.csv"), *FDateTime::Now().ToString()));
+	FFileHelper::SaveStringToFile(TEXT("Time,Connection,GameThreadMsAvg,GameThreadMsMax,OutBytesPerSec,InBytesPerSec,OutPacketsPerSec,InPacketsPerSec,OutLossPercent,AvgLagMs\n"), *CsvFilename);
+}
+
+void UAuraLoadTestSubsystem::Tick(float DeltaTime)
+{
+	// クライアント側（-AuraBot と一緒に付けた場合など）では記録しない
+	if (GetWorld()->GetNetMode() == NM_Client) return;
+
+	ElapsedTime += DeltaTime;
+	TimeSinceSample += DeltaTime;
+
+	// DeltaTimeはNetServerMaxTickRateの待機を含むので、待機を除いたゲームスレッドの処理時間を記録する
+	const float GameThreadTime = FMath::Max(static_cast<float>(FApp::GetDeltaTime() - FApp::GetIdleTime()), 0.f);
+	++NumFrames;
+	TotalGameThreadTime += GameThreadTime;
+	MaxGameThreadTime = FMath::Max(MaxGameThreadTime, GameThreadTime);
+
+	// NetConnectionの毎秒の値は1秒ごとに更新されるので、同じ間隔で取る
+	if (TimeSinceSample >= 1.f)
+	{
+		WriteSample();
+		TimeSinceSample = 0.f;
+		NumFrames = 0;
+		TotalGameThreadTime = 0.f;
+		MaxGameThreadTime = 0.f;
+	}
+
+	if (Duration > 0.f && ElapsedTime >= Duration)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Load test finished after %.0f s, results in %s"), ElapsedTime, *CsvFilename);
+		Duration = 0.f;
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void UAuraLoadTestSubsystem::WriteSample()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver || NumFrames == 0) return;
+
+	const float GameThreadMsAvg = TotalGameThreadTime / NumFrames * 1000.f;
+	const float GameThreadMsMax = MaxGameThreadTime * 1000.f;
+
+	FString Rows;
+	int64 TotalOutBytes = 0;
+	int64 TotalInBytes = 0;
+	for (const UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection) continue;
+
+		TotalOutBytes += Connection->OutBytesPerSecond;
+		TotalInBytes += Connection->InBytesPerSecond;
+		Rows += FString::Printf(TEXT("%.1f,%s,%.2f,%.2f,%d,%d,%d,%d,%.2f,%.1f\n"),
+			ElapsedTime, *Connection->LowLevelGetRemoteAddress(true), GameThreadMsAvg, GameThreadMsMax,
+			Connection->OutBytesPerSecond, Connection->InBytesPerSecond, Connection->OutPacketsPerSecond, Connection->InPacketsPerSecond,
+			Connection->GetOutLossPercentage().GetAvgLossPercentage() * 100.f, Connection->AvgLag * 1000.0);
+	}
+
+	// 接続数に対する伸び方を見るための合計行
+	Rows += FString::Printf(TEXT("%.1f,All(%d),%.2f,%.2f,%lld,%lld,,,,\n"),
+		ElapsedTime, NetDriver->ClientConnections.Num(), GameThreadMsAvg, GameThreadMsMax, TotalOutBytes, TotalInBytes);
+
+	FFileHelper::SaveStringToFile(Rows, *CsvFilename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
+
+TStatId UAuraLoadTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraLoadTestSubsystem, STATGROUP_Tickables);
+}
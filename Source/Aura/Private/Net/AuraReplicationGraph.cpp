@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Net/AuraReplicationGraph.h"
+#include "Actor/AuraEffectActor.h"
+#include "Actor/AuraProjectile.h"
+#include "Characters/AuraEnemy.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "UObject/UObjectIterator.h"
+
+void UAuraReplicationGraph::InitGlobalActorClassSettings()
+{
+	// 読み込み済みの全複製クラスにCDOの頻度とカリング距離を設定する
+	Super::InitGlobalActorClassSettings();
+
+	ClassRepNodePolicies.Set(AAuraEnemy::StaticClass(), EAuraClassRepNodeMapping::Spatialize_Dormancy);	// プール中は休止する
+	ClassRepNodePolicies.Set(AAuraProjectile::StaticClass(), EAuraClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AAuraEffectActor::StaticClass(), EAuraClassRepNodeMapping::Pickup);
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), EAuraClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(AGameStateBase::StaticClass(), EAuraClassRepNodeMapping::RelevantAllConnections);
+
+#if CSV_PROFILER
+	// -csvCaptureFrames のCSVにクラス別の複製時間・送信量を出す（ロードテストの比較用）
+	CSVTracker.SetImplicitClassTracking(AAuraEnemy::StaticClass(), TEXT("AuraEnemy"));
+	CSVTracker.SetImplicitClassTracking(AAuraProjectile::StaticClass(), TEXT("AuraProjectile"));
+	CSVTracker.SetImplicitClassTracking(AAuraEffectActor::StaticClass(), TEXT("AuraEffectActor"));
+	CSVTracker.SetImplicitClassTracking(APlayerState::StaticClass(), TEXT("PlayerState"));
+#endif
+
+	const UAuraReplicationGraphSettings* Settings = GetDefault<UAuraReplicationGraphSettings>();
+	for (const FAuraRepGraphClassSettings& ClassSettings : Settings->ClassSettings)
+	{
+		UClass* ActorClass = ClassSettings.ActorClass.LoadSynchronous();
+		if (!ActorClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AuraReplicationGraph: could not load class [%s]."), *ClassSettings.ActorClass.ToString());
+			continue;
+		}
+
+		ClassRepNodePolicies.Set(ActorClass, ClassSettings.NodeMapping);
+
+		if (ClassSettings.NetUpdateFrequency <= 0.f && ClassSettings.CullDistance <= 0.f)
+		{
+			continue;
+		}
+
+		// Superはクラスごとに設定しているので、読み込み済みの子クラスにも反映する（未読み込みの子クラスは親の設定を使う）
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			UClass* Class = *It;
+			if (!Class->IsChildOf(ActorClass) || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+			{
+				continue;
+			}
+
+			FClassReplicationInfo& ClassInfo = GlobalActorReplicationInfoMap.GetClassInfo(Class);
+			if (ClassSettings.NetUpdateFrequency > 0.f)
+			{
+				ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ClassSettings.NetUpdateFrequency);
+			}
+			if (ClassSettings.CullDistance > 0.f)
+			{
+				ClassInfo.SetCullDistanceSquared(FMath::Square(ClassSettings.CullDistance));
+			}
+		}
+	}
+}
+
+void UAuraReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	const UAuraReplicationGraphSettings* Settings = GetDefault<UAuraReplicationGraphSettings>();
+
+	// まだアクターが入っていないので、ここでセルの大きさを変えても再構築は起きない
+	GridNode->CellSize = Settings->SpatialCellSize;
+	GridNode->SpatialBias = Settings->SpatialBias;
+
+	// ピックアップはほぼ休止しているので、敵の動的リストと分けて粗いグリッドに置く
+	PickupGridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	PickupGridNode->CellSize = Settings->PickupCellSize;
+	PickupGridNode->SpatialBias = Settings->SpatialBias;
+	AddGlobalGraphNode(PickupGridNode);
+}
+
+void UAuraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	// GlobalInfoはクラスの設定のコピーなので、インスタンスで変えた頻度（群衆移動の敵など）はここで反映する
+	const float NetUpdateFrequency = ActorInfo.Actor->NetUpdateFrequency;
+	if (NetUpdateFrequency > 0.f && NetUpdateFrequency != ActorInfo.Class->GetDefaultObject<AActor>()->NetUpdateFrequency)
+	{
+		GlobalInfo.Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(NetUpdateFrequency);
+	}
+
+	const EAuraClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
+	if (Policy == EAuraClassRepNodeMapping::NotRouted || ActorInfo.Actor->bOnlyRelevantToOwner)
+	{
+		Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+		return;
+	}
+
+	switch (Policy)
+	{
+	case EAuraClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case EAuraClassRepNodeMapping::Pickup:
+		PickupGridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void UAuraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const EAuraClassRepNodeMapping Policy = GetMappingPolicy(ActorInfo.Class);
+	if (Policy == EAuraClassRepNodeMapping::NotRouted || ActorInfo.Actor->bOnlyRelevantToOwner)
+	{
+		Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+		return;
+	}
+
+	switch (Policy)
+	{
+	case EAuraClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case EAuraClassRepNodeMapping::Pickup:
+		PickupGridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void UAuraReplicationGraph::SetActorNetUpdateFrequency(AActor* Actor, float NetUpdateFrequency)
+{
+	FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor);
+	if (!GlobalInfo)
+	{
+		return;
+	}
+
+	const uint32 PeriodFrame = GetReplicationPeriodFrameForFrequency(NetUpdateFrequency);
+	GlobalInfo->Settings.ReplicationPeriodFrame = PeriodFrame;
+
+	// 接続ごとの情報は作成時にグローバルの設定をコピーしているので、それぞれ更新する
+	for (UNetReplicationGraphConnection* Connection : Connections)
+	{
+		if (FConnectionReplicationActorInfo* ConnectionInfo = Connection->ActorInfoMap.Find(Actor))
+		{
+			ConnectionInfo->ReplicationPeriodFrame = PeriodFrame;
+		}
+	}
+}
+
+EAuraClassRepNodeMapping UAuraReplicationGraph::GetMappingPolicy(const UClass* Class)
+{
+	// 登録されていないクラスはUBasicReplicationGraphの振り分けに任せる
+	const EAuraClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class);
+	return Policy ? *Policy : EAuraClassRepNodeMapping::NotRouted;
+}
@@ -0,0 +1,350 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Player/AuraCheatManager.h"
+#include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/AuraAttributeSnapshotSubsystem.h"
+#include "AbilitySystem/Data/AuraAbilitySet.h"
+#include "AuraGameplayTags.h"
+#include "Characters/AuraEnemy.h"
+#include "Characters/AuraEnemySpawnDirector.h"
+#include "AuraSpatialHashSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Components/SphereComponent.h"
+#include "Engine/DataTable.h"
+#include "EngineUtils.h"
+#include "UI/WidgetController/OverlayWidgetController.h"
+
+namespace AuraCheat
+{
+	// プレイヤーの前方に格子状に配置
+	FVector GetGridLocation(const APawn* Pawn, int32 Index, int32 Count)
+	{
+		const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+		const float Spacing = 150.f;
+		const FVector Origin = Pawn->GetActorLocation() + Pawn->GetActorForwardVector() * 500.f;
+		return Origin + FVector((Index / Columns - Columns / 2) * Spacing, (Index % Columns - Columns / 2) * Spacing, 0.f);
+	}
+}
+
+void UAuraCheatManager::SpawnEnemies(const FString& EnemyClassPath, int32 Count)
+{
+	UWorld* World = GetWorld();
+	const APawn* Pawn = GetOuterAPlayerController()->GetPawn();
+	if (!World || !Pawn || World->GetNetMode() == NM_Client) return;
+
+	UClass* EnemyClass = LoadClass<AAuraEnemy>(nullptr, *EnemyClassPath);
+	if (!EnemyClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpawnEnemies: can't load enemy class [%s]."), *EnemyClassPath);
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		World->SpawnActor<AAuraEnemy>(EnemyClass, AuraCheat::GetGridLocation(Pawn, Index, Count), FRotator::ZeroRotator, SpawnParams);
+	}
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// Aura.AttributeSnapshots 0/1 で初期化コストを比較できる
+	UE_LOG(LogTemp, Log, TEXT("SpawnEnemies: %d x %s in %.2f ms (%.3f ms each, attribute snapshots %s)"),
+		Count, *EnemyClass->GetName(), ElapsedMs, ElapsedMs / FMath::Max(Count, 1),
+		UAuraAttributeSnapshotSubsystem::IsEnabled() ? TEXT("on") : TEXT("off"));
+}
+
+void UAuraCheatManager::SpawnEnemyWave(const FString& EnemyClassPath, int32 Count, int32 Prewarm)
+{
+	UWorld* World = GetWorld();
+	const APawn* Pawn = GetOuterAPlayerController()->GetPawn();
+	UAuraEnemySpawnDirector* SpawnDirector = World ? World->GetSubsystem<UAuraEnemySpawnDirector>() : nullptr;
+	if (!SpawnDirector || !Pawn || World->GetNetMode() == NM_Client) return;
+
+	UClass* EnemyClass = LoadClass<AAuraEnemy>(nullptr, *EnemyClassPath);
+	if (!EnemyClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpawnEnemyWave: can't load enemy class [%s]."), *EnemyClassPath);
+		return;
+	}
+
+	if (Prewarm > 0)
+	{
+		SpawnDirector->PrewarmEnemies(EnemyClass, Prewarm);
+		UE_LOG(LogTemp, Log, TEXT("SpawnEnemyWave: prewarming %d x %s, run again without Prewarm once stat Aura shows the pool is full."),
+			Prewarm, *EnemyClass->GetName());
+		return;
+	}
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		SpawnDirector->QueueSpawn(EnemyClass, FTransform(AuraCheat::GetGridLocation(Pawn, Index, Count)));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("SpawnEnemyWave: queued %d x %s (%d pooled). Compare the frame times with SpawnEnemies in stat Aura / stat unitgraph."),
+		Count, *EnemyClass->GetName(), SpawnDirector->GetNumPooledEnemies(EnemyClass));
+}
+
+void UAuraCheatManager::KillAllEnemies()
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client) return;
+
+	for (TActorIterator<AAuraEnemy> It(World); It; ++It)
+	{
+		It->Die();
+	}
+}
+
+void UAuraCheatManager::BenchAbilityGrants(const FString& AbilitySetPath, int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client) return;
+
+	const UAuraAbilitySet* AbilitySet = LoadObject<UAuraAbilitySet>(nullptr, *AbilitySetPath);
+	if (!AbilitySet)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BenchAbilityGrants: can't load AbilitySet [%s]."), *AbilitySetPath);
+		return;
+	}
+
+	// 従来の付与方法用のクラス一覧
+	TArray<TSubclassOf<UGameplayAbility>> AbilityClasses;
+	for (const FAuraAbilitySetEntry& Entry : AbilitySet->GrantedAbilities)
+	{
+		AbilityClasses.Add(Entry.Ability);
+	}
+
+	AAuraEnemy* Enemy = World->SpawnActor<AAuraEnemy>();
+	if (!Enemy) return;
+	UAuraAbilitySystemComponent* AuraASC = CastChecked<UAuraAbilitySystemComponent>(Enemy->GetAbilitySystemComponent());
+	AuraASC->ClearAllAbilities();
+
+	double LegacySeconds = 0.0;
+	double AbilitySetSeconds = 0.0;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		AuraASC->AddCharacterAbilities(AbilityClasses);
+		LegacySeconds += FPlatformTime::Seconds() - StartTime;
+		AuraASC->ClearAllAbilities();
+
+		StartTime = FPlatformTime::Seconds();
+		AuraASC->GiveAbilitySet(AbilitySet);
+		AbilitySetSeconds += FPlatformTime::Seconds() - StartTime;
+		AuraASC->ClearAllAbilities();
+	}
+
+	Enemy->Destroy();
+
+	UE_LOG(LogTemp, Log, TEXT("BenchAbilityGrants: %d grants of %d abilities. AddCharacterAbilities %.2f ms, GiveAbilitySet %.2f ms"),
+		Count, AbilityClasses.Num(), LegacySeconds * 1000.0, AbilitySetSeconds * 1000.0);
+}
+
+void UAuraCheatManager::BenchNativeTagQueries(int32 Iterations)
+{
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+
+	// HasAnyの問い合わせ（入力タグ3つ）
+	FGameplayTagContainer AnyQuery;
+	AnyQuery.AddTag(GameplayTags.InputTag_1);
+	AnyQuery.AddTag(GameplayTags.InputTag_3);
+	AnyQuery.AddTag(GameplayTags.Message);
+	const FAuraNativeTagBits AnyQueryBits = GameplayTags.GetMatchBits(AnyQuery);
+
+	for (const int32 ContainerSize : { 1, 4, 8, 16 })
+	{
+		FGameplayTagContainer Container;
+		for (int32 Index = 0; Index < ContainerSize; ++Index)
+		{
+			Container.AddTag(GameplayTags.GetNativeTag(static_cast<EAuraNativeTag>(Index % AuraNativeTagCount)));
+		}
+		const FAuraNativeTagBits ContainerBits = GameplayTags.GetMatchBits(Container);
+
+		// 最適化で消されないようにヒット数を数える
+		int32 ContainerHits = 0;
+		int32 BitsetHits = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const FGameplayTag& Tag = GameplayTags.GetNativeTag(static_cast<EAuraNativeTag>(Iteration % AuraNativeTagCount));
+			ContainerHits += Container.HasTag(Tag) ? 1 : 0;
+			ContainerHits += Container.HasAny(AnyQuery) ? 1 : 0;
+		}
+		const double ContainerMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const EAuraNativeTag Tag = static_cast<EAuraNativeTag>(Iteration % AuraNativeTagCount);
+			BitsetHits += (ContainerBits & AuraNativeTagBit(Tag)) != 0 ? 1 : 0;
+			BitsetHits += (ContainerBits & AnyQueryBits) != 0 ? 1 : 0;
+		}
+		const double BitsetMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		UE_LOG(LogTemp, Log, TEXT("BenchNativeTagQueries: %2d tags, %d x (HasTag + HasAny). Container %.3f ms, Bitset %.3f ms (hits %d / %d)"),
+			ContainerSize, Iterations, ContainerMs, BitsetMs, ContainerHits, BitsetHits);
+	}
+}
+
+void UAuraCheatManager::BenchOverlayMessageTags(const FString& DataTablePath, int32 Iterations)
+{
+	const UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *DataTablePath);
+	TMap<FGameplayTag, const FUIWidgetRow*> MessageRows;
+	if (!DataTable || !UOverlayWidgetController::BuildMessageWidgetRowMap(DataTable, MessageRows))
+	{
+		UE_LOG(LogTemp, Error, TEXT("BenchOverlayMessageTags: can't load message DataTable [%s]."), *DataTablePath);
+		return;
+	}
+
+	// GE 1つ分のアセットタグ10個：表にあるメッセージタグと、メッセージ以外のネイティブタグを混ぜる
+	constexpr int32 TagsPerEffect = 10;
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+	FGameplayTagContainer AssetTags;
+	for (const TPair<FGameplayTag, const FUIWidgetRow*>& Pair : MessageRows)
+	{
+		if (AssetTags.Num() >= TagsPerEffect / 2) break;
+		AssetTags.AddTag(Pair.Key);
+	}
+	for (int32 Index = 0; AssetTags.Num() < TagsPerEffect && Index < AuraNativeTagCount; ++Index)
+	{
+		AssetTags.AddTag(GameplayTags.GetNativeTag(static_cast<EAuraNativeTag>(Index)));
+	}
+
+	// 最適化で消されないようにヒット数を数える
+	int32 LegacyHits = 0;
+	int32 MapHits = 0;
+
+	// 従来：タグごとにMessageタグを名前で引き、FindRowして行をコピーしてブロードキャストしていた
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FGameplayTag& Tag : AssetTags)
+		{
+			const FGameplayTag MessageTag = FGameplayTag::RequestGameplayTag(FName("Message"));
+			if (!Tag.MatchesTag(MessageTag)) continue;
+
+			if (const FUIWidgetRow* Row = DataTable->FindRow<FUIWidgetRow>(Tag.GetTagName(), TEXT(""), false))
+			{
+				const FUIWidgetRow RowCopy = *Row;
+				LegacyHits += RowCopy.MessageWidget ? 2 : 1;
+			}
+		}
+	}
+	const double LegacyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// 現在：キャッシュしたMessageタグとタグ→行マップ（行は参照のまま）
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		const FGameplayTag& MessageTag = GameplayTags.Message;
+		for (const FGameplayTag& Tag : AssetTags)
+		{
+			if (!Tag.MatchesTag(MessageTag)) continue;
+
+			if (const FUIWidgetRow* const* Row = MessageRows.Find(Tag))
+			{
+				MapHits += (*Row)->MessageWidget ? 2 : 1;
+			}
+		}
+	}
+	const double MapMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// Blueprintのリスナーへのブロードキャスト（引数のマーシャリング）は両方に共通なので含めない
+	UE_LOG(LogTemp, Log, TEXT("BenchOverlayMessageTags: %d effects x %d asset tags (%d rows). FindRow %.3f ms, Tag map %.3f ms (hits %d / %d)"),
+		Iterations, AssetTags.Num(), MessageRows.Num(), LegacyMs, MapMs, LegacyHits, MapHits);
+}
+
+void UAuraCheatManager::BenchSpatialQueries(int32 NumActors, int32 NumQueries, float Radius)
+{
+	UWorld* World = GetWorld();
+	const APawn* Pawn = GetOuterAPlayerController()->GetPawn();
+	UAuraSpatialHashSubsystem* SpatialHash = World ? World->GetSubsystem<UAuraSpatialHashSubsystem>() : nullptr;
+	if (!SpatialHash || !Pawn || NumActors <= 0 || NumQueries <= 0) return;
+
+	// プレイヤーの周りの正方形にランダムに配置する（敵と同じ大きさの球）
+	const float HalfExtent = 50.f * FMath::Sqrt(static_cast<float>(NumActors)) * 2.f;
+	const FVector Origin = Pawn->GetActorLocation();
+	FRandomStream Random(NumActors);
+
+	TArray<AActor*> Actors;
+	Actors.Reserve(NumActors);
+	for (int32 Index = 0; Index < NumActors; ++Index)
+	{
+		const FVector Location = Origin + FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.f);
+		AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location));
+		if (!Actor) continue;
+
+		USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+		Sphere->InitSphereRadius(40.f);
+		Sphere->SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
+		Actor->SetRootComponent(Sphere);
+		Sphere->RegisterComponent();
+		Sphere->SetWorldLocation(Location);
+
+		SpatialHash->RegisterActor(Actor, EAuraSpatialCategory::Combatant);
+		Actors.Add(Actor);
+	}
+	SpatialHash->FlushPendingUpdates();
+
+	TArray<FVector> QueryCenters;
+	QueryCenters.Reserve(NumQueries);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		QueryCenters.Add(Origin + FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.f));
+	}
+
+	// 最適化で消されないようにヒット数を数える
+	int32 OverlapHits = 0;
+	double StartTime = FPlatformTime::Seconds();
+	{
+		TArray<FOverlapResult> Overlaps;
+		const FCollisionShape Sphere = FCollisionShape::MakeSphere(Radius);
+		for (const FVector& Center : QueryCenters)
+		{
+			Overlaps.Reset();
+			World->OverlapMultiByChannel(Overlaps, Center, FQuat::Identity, ECC_WorldDynamic, Sphere);
+			OverlapHits += Overlaps.Num();
+		}
+	}
+	const double OverlapMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	const UAuraSpatialHashSubsystem::FSnapshotPtr Snapshot = SpatialHash->GetSnapshot();
+	int32 HashHits = 0;
+	StartTime = FPlatformTime::Seconds();
+	{
+		TArray<FAuraSpatialHashEntry> Entries;
+		for (const FVector& Center : QueryCenters)
+		{
+			Entries.Reset();
+			Snapshot->QueryRadius(Center, Radius, EAuraSpatialCategory::Combatant, Entries);
+			HashHits += Entries.Num();
+		}
+	}
+	const double HashMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// 同じ問い合わせをワーカースレッドに分散
+	std::atomic<int32> ParallelHits = 0;
+	StartTime = FPlatformTime::Seconds();
+	ParallelFor(QueryCenters.Num(), [&](int32 Index)
+	{
+		TArray<FAuraSpatialHashEntry> Results;
+		Snapshot->QueryRadius(QueryCenters[Index], Radius, EAuraSpatialCategory::Combatant, Results);
+		ParallelHits += Results.Num();
+	});
+	const double ParallelMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// 一時的なアクターなのでEndPlayでの登録解除は無い
+	for (AActor* Actor : Actors)
+	{
+		SpatialHash->UnregisterActor(Actor);
+		Actor->Destroy();
+	}
+
+	// Overlapのヒット数には床など他のアクターも含まれる
+	UE_LOG(LogTemp, Log, TEXT("BenchSpatialQueries: %d actors, %d radius queries (r=%.0f). OverlapMultiByChannel %.2f ms (%d hits), SpatialHash %.2f ms (%d hits), SpatialHash parallel %.2f ms"),
+		Actors.Num(), NumQueries, Radius, OverlapMs, OverlapHits, HashMs, HashHits, ParallelMs);
+}
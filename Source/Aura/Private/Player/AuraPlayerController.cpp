@@ -3,18 +3,28 @@
 
 #include "Player/AuraPlayerController.h"
 #include "AbilitySystemBlueprintLibrary.h"
-#include "AuraGameplayTags.h"
 #include "EnhancedInputSubsystems.h"
 #include "NavigationPath.h"
 #include "NavigationSystem.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "Components/SplineComponent.h"
 #include "Input/AuraEnhancedInputComponent.h"
+#include "Player/AuraCheatManager.h"
 #include "Interaction/EnemyInterface.h"  
+#include "AbilitySystem/Abilities/AuraProjectileSpell.h"
+#include "AuraCosmetics.h"
+#include "AuraSpatialHashSubsystem.h"
+#include "Misc/CommandLine.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ability Input Pressed"), STAT_AuraAbilityInputPressed, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("Ability Input Released"), STAT_AuraAbilityInputReleased, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("Ability Input Held"), STAT_AuraAbilityInputHeld, STATGROUP_Aura);
 
 AAuraPlayerController::AAuraPlayerController()
 {
 	bReplicates = true;
+	CheatClass = UAuraCheatManager::StaticClass();
 
 	Spline = CreateDefaultSubobject<USplineComponent>(TEXT("Spline"));
 }
@@ -24,6 +34,10 @@ void AAuraPlayerController::PlayerTick(float DeltaTime)
 	Super::PlayerTick(DeltaTime);
 
 	CursorTrace();
+	if (bBotEnabled)
+	{
+		TickBot(DeltaTime);
+	}
 	AutoRun();
 }
 
@@ -47,6 +61,10 @@ void AAuraPlayerController::BeginPlay()
 	InputModeData.SetLockMouseToViewportBehavior(EMouseLockMode::DoNotLock);
 	InputModeData.SetHideCursorDuringCapture(false);
 	SetInputMode(InputModeData);
+
+	// 同時に起動したボットが同じタイミングで動かないようにずらす
+	bBotEnabled = IsLocalController() && FParse::Param(FCommandLine::Get(), TEXT("AuraBot"));
+	BotTimeToNextAction = FMath::FRandRange(0.f, BotActionInterval);
 }
 
 void AAuraPlayerController::SetupInputComponent()
@@ -76,12 +94,28 @@ void AAuraPlayerController::SetupInputComponent()
 		&AAuraPlayerController::ShiftReleased
 	);
 
+	// ハンドラ表の作成：LMBだけ移動処理付きのハンドラを割り当てる
+	using FSlotHandler = void (ThisClass::*)(EAuraInputSlot);
+	TAuraInputSlotHandlers<FSlotHandler> PressedHandlers(InPlace, &ThisClass::AbilityInputPressed);
+	TAuraInputSlotHandlers<FSlotHandler> ReleasedHandlers(InPlace, &ThisClass::AbilityInputReleased);
+	TAuraInputSlotHandlers<FSlotHandler> HeldHandlers(InPlace, &ThisClass::AbilityInputHeld);
+
+	const int32 LMBIndex = static_cast<int32>(EAuraInputSlot::LMB);
+	PressedHandlers[LMBIndex] = &ThisClass::LMBInputPressed;
+	ReleasedHandlers[LMBIndex] = &ThisClass::LMBInputReleased;
+	HeldHandlers[LMBIndex] = &ThisClass::LMBInputHeld;
+
+	for (int32 Index = 0; Index < AuraInputSlotCount; ++Index)
+	{
+		SlotInputTags[Index] = UAuraInputConfig::GetInputTagForSlot(static_cast<EAuraInputSlot>(Index));
+	}
+
 	AuraInputComponent->BindAbilityActions(
 		InputConfig,
 		this,
-		&ThisClass::AbilityInputTagPressed,
-		&ThisClass::AbilityInputTagReleased,
-		&ThisClass::AbilityInputTagHeld
+		PressedHandlers,
+		ReleasedHandlers,
+		HeldHandlers
 	);
 }
 
@@ -110,63 +144,59 @@ void AAuraPlayerController::CursorTrace()
 	LastActor = ThisActor;
 	ThisActor = CursorHit.GetActor();
 
-	if (LastActor != ThisActor)
+	// CursorHit・ThisActorはクリック移動やターゲットにも使うので、見た目の処理（ハイライト）だけを省く
+	if (LastActor != ThisActor && AuraShouldRunCosmetics(this))
 	{
 		if (LastActor) LastActor->UnHighlightActor();
 		if (ThisActor) ThisActor->HighlightActor();
 	}
+}
 
-	
+void AAuraPlayerController::AbilityInputPressed(EAuraInputSlot Slot)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraAbilityInputPressed);
+
+	if (GetASC()) GetASC()->AbilityInputTagPressed(SlotInputTags[static_cast<int32>(Slot)]);
 }
 
-void AAuraPlayerController::AbilityInputTagPressed(FGameplayTag InputTag)
+void AAuraPlayerController::AbilityInputReleased(EAuraInputSlot Slot)
 {
-	if (InputTag.MatchesTagExact(FAuraGameplayTags::Get().InputTag_LMB))
-	{
-		// 左マウスクリック時、クリック対象が敵か否か
-		bTargeting = ThisActor ? true : false;
-		bAutoRunning = false;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_AuraAbilityInputReleased);
+
+	if (GetASC()) GetASC()->AbilityInputTagReleased(SlotInputTags[static_cast<int32>(Slot)]);
 }
 
-void AAuraPlayerController::AbilityInputTagReleased(FGameplayTag InputTag)
+void AAuraPlayerController::AbilityInputHeld(EAuraInputSlot Slot)
 {
-	// 左マウス以外の時
-	if (!InputTag.MatchesTagExact(FAuraGameplayTags::Get().InputTag_LMB))
-	{
-		if (GetASC()) GetASC()->AbilityInputTagHeld(InputTag);
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_AuraAbilityInputHeld);
+
+	if (GetASC()) GetASC()->AbilityInputTagHeld(SlotInputTags[static_cast<int32>(Slot)]);
+}
+
+void AAuraPlayerController::LMBInputPressed(EAuraInputSlot Slot)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraAbilityInputPressed);
 
-	// 常にASCに通知
-	if (GetASC()) GetASC()->AbilityInputTagHeld(InputTag);
+	// 左マウスクリック時、クリック対象が敵か否か
+	bTargeting = ThisActor ? true : false;
+	bAutoRunning = false;
+}
+
+void AAuraPlayerController::LMBInputReleased(EAuraInputSlot Slot)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraAbilityInputReleased);
+
+	// 常にASCに通知（押下状態の終了）
+	if (GetASC()) GetASC()->AbilityInputTagReleased(SlotInputTags[static_cast<int32>(Slot)]);
 	
-	/* 左マウスの場合 */
 	// 敵をクリックした時
 	if (!bTargeting || bShiftKeyDown)
 	{
 		// 何もターゲットしていない：ワンクリック移動
-		const APawn* ControllerPawn = GetPawn<APawn>();
-		if (FollowTime <= ShortPressThreshold && ControllerPawn)
+		if (FollowTime <= ShortPressThreshold)
 		{
 			// 短押し判定、パスファインディング処理の実装
-			if (UNavigationPath* NavPath = UNavigationSystemV1::FindPathToLocationSynchronously(
-				this,
-				ControllerPawn->GetActorLocation(),
-				CachedDestination
-			))
-			{
-				/* 移動処理 */
-				// 既存のSplineポイントをクリア
-				Spline->ClearSplinePoints();
-
-				for (const FVector& PointLocation : NavPath->PathPoints)
-				{
-					// Navpathの経由地をSplineに追加
-					Spline->AddSplinePoint(PointLocation, ESplineCoordinateSpace::World);
-				}
-				bAutoRunning = true;
-			}
+			MoveToLocation(CachedDestination);
 		}
 
 		// 状態リセット
@@ -175,20 +205,14 @@ void AAuraPlayerController::AbilityInputTagReleased(FGameplayTag InputTag)
 	}
 }
 
-void AAuraPlayerController::AbilityInputTagHeld(FGameplayTag InputTag)
+void AAuraPlayerController::LMBInputHeld(EAuraInputSlot Slot)
 {
-	// 左マウスボタン以外の処理
-	if (!InputTag.MatchesTagExact(FAuraGameplayTags::Get().InputTag_LMB))
-	{
-		if (GetASC()) GetASC()->AbilityInputTagHeld(InputTag);
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_AuraAbilityInputHeld);
 
-	/* 左マウスの場合 */
 	// 敵をクリックした時
 	if (bTargeting || bShiftKeyDown)
 	{
-		if (GetASC()) GetASC()->AbilityInputTagHeld(InputTag);
+		if (GetASC()) GetASC()->AbilityInputTagHeld(SlotInputTags[static_cast<int32>(Slot)]);
 	}
 	else
 	{
@@ -210,6 +234,31 @@ void AAuraPlayerController::AbilityInputTagHeld(FGameplayTag InputTag)
 	
 }
 
+void AAuraPlayerController::MoveToLocation(const FVector& Destination)
+{
+	const APawn* ControllerPawn = GetPawn<APawn>();
+	if (!ControllerPawn) return;
+
+	if (UNavigationPath* NavPath = UNavigationSystemV1::FindPathToLocationSynchronously(
+		this,
+		ControllerPawn->GetActorLocation(),
+		Destination
+	))
+	{
+		/* 移動処理 */
+		// 既存のSplineポイントをクリア
+		Spline->ClearSplinePoints();
+
+		for (const FVector& PointLocation : NavPath->PathPoints)
+		{
+			// Navpathの経由地をSplineに追加
+			Spline->AddSplinePoint(PointLocation, ESplineCoordinateSpace::World);
+		}
+		CachedDestination = Destination;
+		bAutoRunning = true;
+	}
+}
+
 UAuraAbilitySystemComponent* AAuraPlayerController::GetASC()
 {
 	if ( AuraAbilitySystemComponent == nullptr)
@@ -242,3 +291,103 @@ void AAuraPlayerController::AutoRun()
 		}
 	}
 }
+
+bool AAuraPlayerController::GetBotTargetHit(FHitResult& OutHit) const
+{
+	if (!bBotEnabled || !bHasBotTarget) return false;
+
+	OutHit = FHitResult();
+	OutHit.bBlockingHit = true;
+	OutHit.Location = OutHit.ImpactPoint = BotTargetLocation;
+	OutHit.HitObjectHandle = FActorInstanceHandle(BotTargetActor.Get());
+	return true;
+}
+
+void AAuraPlayerController::TickBot(float DeltaTime)
+{
+	BotTimeToNextAction -= DeltaTime;
+	if (BotTimeToNextAction > 0.f || !GetPawn()) return;
+
+	BotTimeToNextAction = BotActionInterval * FMath::FRandRange(0.75f, 1.25f);
+
+	// クリック移動・投射物スペル・ピックアップを一定の割合で混ぜる
+	const float Roll = FMath::FRand();
+	if (Roll < 0.4f)
+	{
+		BotMoveRandomly();
+	}
+	else if (Roll < 0.8f)
+	{
+		BotCastProjectile();
+	}
+	else
+	{
+		BotMoveToPickup();
+	}
+}
+
+void AAuraPlayerController::BotMoveRandomly()
+{
+	const UNavigationSystemV1* NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSystem) return;
+
+	FNavLocation Destination;
+	if (NavSystem->GetRandomReachablePointInRadius(GetPawn()->GetActorLocation(), BotMoveRadius, Destination))
+	{
+		MoveToLocation(Destination.Location);
+	}
+}
+
+void AAuraPlayerController::BotCastProjectile()
+{
+	if (!GetASC()) return;
+
+	const APawn* ControllerPawn = GetPawn();
+	const FVector PawnLocation = ControllerPawn->GetActorLocation();
+
+	// 一番近い戦闘アクター（自分以外）を狙い、いなければ正面を撃つ
+	bHasBotTarget = true;
+	BotTargetActor.Reset();
+	BotTargetLocation = PawnLocation + ControllerPawn->GetActorForwardVector() * 1000.f;
+
+	TArray<FAuraSpatialHashEntry> Entries;
+	if (const UAuraSpatialHashSubsystem::FSnapshotPtr Snapshot = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>()->GetSnapshot())
+	{
+		Snapshot->QueryNearest(PawnLocation, 2, BotSearchRadius, EAuraSpatialCategory::Combatant, Entries);
+	}
+	for (const FAuraSpatialHashEntry& Entry : Entries)
+	{
+		if (Entry.Actor.Get() != ControllerPawn)
+		{
+			BotTargetActor = Entry.Actor;
+			BotTargetLocation = Entry.Location;
+			break;
+		}
+	}
+
+	for (const FGameplayAbilitySpec& AbilitySpec : GetASC()->GetActivatableAbilities())
+	{
+		if (AbilitySpec.Ability && AbilitySpec.Ability->IsA<UAuraProjectileSpell>())
+		{
+			GetASC()->TryActivateAbility(AbilitySpec.Handle);
+			return;
+		}
+	}
+}
+
+void AAuraPlayerController::BotMoveToPickup()
+{
+	TArray<FAuraSpatialHashEntry> Entries;
+	if (const UAuraSpatialHashSubsystem::FSnapshotPtr Snapshot = GetWorld()->GetSubsystem<UAuraSpatialHashSubsystem>()->GetSnapshot())
+	{
+		Snapshot->QueryNearest(GetPawn()->GetActorLocation(), 1, BotSearchRadius, EAuraSpatialCategory::EffectActor, Entries);
+	}
+	if (Entries.Num() > 0)
+	{
+		MoveToLocation(Entries[0].Location);
+	}
+	else
+	{
+		BotMoveRandomly();
+	}
+}
@@ -4,7 +4,10 @@
 #include "Player/AuraPlayerState.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAttributeSet.h"
+#include "Engine/NetDriver.h"
+#include "Net/AuraReplicationGraph.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 AAuraPlayerState::AAuraPlayerState()
 {
@@ -14,14 +17,55 @@ AAuraPlayerState::AAuraPlayerState()
 
 	AttributeSet = CreateDefaultSubobject<UAuraAttributeSet>("AttributeSet");
 
-	NetUpdateFrequency = 100.0f;
+	// BeginPlayまでは戦闘中の頻度で初期状態を送り、以降は変化に応じて切り替える
+	NetUpdateFrequency = CombatNetUpdateFrequency;
+	MinNetUpdateFrequency = IdleNetUpdateFrequency;
+}
+
+void AAuraPlayerState::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!HasAuthority()) return;
+
+	TArray<FGameplayAttribute> Attributes;
+	UAttributeSet::GetAttributesFromSetClass(AttributeSet->GetClass(), Attributes);
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &AAuraPlayerState::OnAttributeChanged);
+	}
+	AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &AAuraPlayerState::OnGameplayEffectApplied);
+	AbilitySystemComponent->OnAnyGameplayEffectRemovedDelegate().AddUObject(this, &AAuraPlayerState::OnGameplayEffectRemoved);
+
+	// Abilityの付与・有効化・終了（予測キーの応答を含む）とルーズタグの変化も複製が必要
+	CastChecked<UAuraAbilitySystemComponent>(AbilitySystemComponent)->AbilityGivenDelegate.AddUObject(this, &AAuraPlayerState::OnAbilityGiven);
+	AbilitySystemComponent->AbilityActivatedCallbacks.AddUObject(this, &AAuraPlayerState::OnAbilityActivated);
+	AbilitySystemComponent->OnAbilityEnded.AddUObject(this, &AAuraPlayerState::OnAbilityEnded);
+	AbilitySystemComponent->RegisterGenericGameplayTagEvent().AddUObject(this, &AAuraPlayerState::OnGameplayTagChanged);
+
+	NotifyCombatActivity();
 }
 
 void AAuraPlayerState::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AAuraPlayerState, Level);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraPlayerState, Level, Params);
+}
+
+void AAuraPlayerState::SetPlayerLevel(int32 InLevel)
+{
+	if (Level == InLevel) return;
+
+	Level = InLevel;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraPlayerState, Level, this);
+
+	if (HasAuthority())
+	{
+		NotifyCombatActivity();
+	}
 }
 
 
@@ -34,3 +78,80 @@ void AAuraPlayerState::OnRep_Level(int32 OldLevel)
 {
 	
 }
+
+void AAuraPlayerState::OnAttributeChanged(const FOnAttributeChangeData& Data)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::OnGameplayEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::OnGameplayEffectRemoved(const FActiveGameplayEffect& Effect)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::OnAbilityGiven(const FGameplayAbilitySpec& AbilitySpec)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::OnAbilityActivated(UGameplayAbility* Ability)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::OnAbilityEnded(const FAbilityEndedData& EndedData)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::OnGameplayTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	NotifyCombatActivity();
+}
+
+void AAuraPlayerState::NotifyCombatActivity()
+{
+	LastCombatActivityTime = GetWorld()->GetTimeSeconds();
+	if (bInCombat) return;
+
+	bInCombat = true;
+	SetReplicationFrequency(CombatNetUpdateFrequency);
+
+	// アイドル中の周期を待たずに最初の変化を送る
+	ForceNetUpdate();
+
+	GetWorldTimerManager().SetTimer(CombatCooldownTimer, this, &AAuraPlayerState::CheckCombatCooldown, FMath::Max(CombatCooldown, 0.1f), false);
+}
+
+void AAuraPlayerState::CheckCombatCooldown()
+{
+	// 変化のたびにタイマーを張り直さず、満了時に残り時間を見て延長する
+	const double Remaining = LastCombatActivityTime + CombatCooldown - GetWorld()->GetTimeSeconds();
+	if (Remaining > UE_KINDA_SMALL_NUMBER)
+	{
+		GetWorldTimerManager().SetTimer(CombatCooldownTimer, this, &AAuraPlayerState::CheckCombatCooldown, Remaining, false);
+		return;
+	}
+
+	bInCombat = false;
+	SetReplicationFrequency(IdleNetUpdateFrequency);
+}
+
+void AAuraPlayerState::SetReplicationFrequency(float Frequency)
+{
+	NetUpdateFrequency = Frequency;
+
+	// ReplicationGraphはNetUpdateFrequencyを登録時にしか読まない
+	if (const UNetDriver* NetDriver = GetNetDriver())
+	{
+		if (UAuraReplicationGraph* ReplicationGraph = NetDriver->GetReplicationDriver<UAuraReplicationGraph>())
+		{
+			ReplicationGraph->SetActorNetUpdateFrequency(this, Frequency);
+		}
+	}
+}
@@ -5,6 +5,7 @@
 #include "UI/Widget/AuraUserWidget.h"
 #include "UI/WidgetController/OverlayWidgetController.h"
 #include "UI/WidgetController/AuraMenuWidgetController.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
 UOverlayWidgetController* AAuraHUD::GetOverlayWidgetController(const FWidgetControllerParams& WCParams)
 {
@@ -33,19 +34,41 @@ UAuraMenuWidgetController* AAuraHUD::GetAttributeMenuWidgetController(const FWid
 
 void AAuraHUD::InitOverlay(APlayerController* PC, APlayerState* PS, UAbilitySystemComponent* ASC, UAttributeSet* AS)
 {
-	checkf(OverlayWidgetClass, TEXT("Overlay Widget Class uninitialized, please fill out BP_AuraHUD."));
+	checkf(!OverlayWidgetClass.IsNull(), TEXT("Overlay Widget Class uninitialized, please fill out BP_AuraHUD."));
 	checkf(OverlayWidgetControllerClass, TEXT("Overlay Widget Controller Class uninitialized, please fill out BP_AuraHUD."));
-	
-	UUserWidget* Widget = CreateWidget<UUserWidget>(GetWorld(), OverlayWidgetClass);
-	OverlayWidget = Cast<UAuraUserWidget>(Widget);
 
 	const FWidgetControllerParams WidgetControllerParamsParams(PC, PS, ASC, AS);
 	UOverlayWidgetController* WidgetController = GetOverlayWidgetController(WidgetControllerParamsParams); 
 
-	OverlayWidget->SetWidgetController(WidgetController);
-	WidgetController->BroadcastInitialValues();
+	// キャラクターの初期化と並行して読み込む
+	OverlayRequestTime = FPlatformTime::Seconds();
+	TRACE_BOOKMARK(TEXT("Aura.OverlayLoadRequested"));
+
+	const TArray<FSoftObjectPath> OverlayAssets = { OverlayWidgetClass.ToSoftObjectPath() };
+	WidgetController->LoadAssets(FSimpleDelegate::CreateUObject(this, &AAuraHUD::ShowOverlay), OverlayAssets);
+}
+
+void AAuraHUD::ShowOverlay()
+{
+	// 2回目以降のInitOverlay（再ポゼッション等）では作り直さない
+	if (OverlayWidget) return;
+
+	UClass* WidgetClass = OverlayWidgetClass.Get();
+	if (!WidgetClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load Overlay Widget Class [%s]."), *OverlayWidgetClass.ToString());
+		return;
+	}
+
+	UUserWidget* Widget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+	OverlayWidget = Cast<UAuraUserWidget>(Widget);
+
+	OverlayWidget->SetWidgetController(OverlayWidgetController);
+	OverlayWidgetController->BroadcastInitialValues();
 	
 	Widget->AddToViewport();
 
+	TRACE_BOOKMARK(TEXT("Aura.OverlayShown"));
+	UE_LOG(LogTemp, Log, TEXT("Overlay shown %.2f ms after InitOverlay, %.2f s after world start."),
+		(FPlatformTime::Seconds() - OverlayRequestTime) * 1000.0, GetWorld()->GetRealTimeSeconds());
 }
-
@@ -2,9 +2,57 @@
 
 
 #include "UI/Widget/AuraUserWidget.h"
+#include "UI/Widget/AuraWidgetPoolSubsystem.h"
+#include "UI/WidgetController/AuraMenuWidgetController.h"
 
 void UAuraUserWidget::SetWidgetController(UObject* InWidgetController)
 {
 	WidgetController = InWidgetController;
+	UpdateMenuControllerOpen();
 	WidgetControllerSet();
 }
+
+void UAuraUserWidget::NativeConstruct()
+{
+	// BPのConstructでSetWidgetControllerされる場合もあるので先に立てる
+	bConstructed = true;
+	Super::NativeConstruct();
+
+	UpdateMenuControllerOpen();
+}
+
+void UAuraUserWidget::NativeDestruct()
+{
+	bConstructed = false;
+	UpdateMenuControllerOpen();
+
+	Super::NativeDestruct();
+}
+
+void UAuraUserWidget::UpdateMenuControllerOpen()
+{
+	UAuraMenuWidgetController* MenuController = bConstructed ? Cast<UAuraMenuWidgetController>(WidgetController) : nullptr;
+	if (OpenedMenuController.Get() == MenuController) return;
+
+	if (UAuraMenuWidgetController* Previous = OpenedMenuController.Get())
+	{
+		Previous->MenuClosed();
+	}
+	OpenedMenuController = MenuController;
+	if (MenuController)
+	{
+		MenuController->MenuOpened();
+	}
+}
+
+void UAuraUserWidget::OnAnimationFinished_Implementation(const UWidgetAnimation* Animation)
+{
+	Super::OnAnimationFinished_Implementation(Animation);
+
+	if (!bReleaseToPoolOnAnimationFinished || bInPool || IsAnyAnimationPlaying()) return;
+
+	if (UAuraWidgetPoolSubsystem* Pool = OwningPool.Get())
+	{
+		Pool->ReleaseWidget(this);
+	}
+}
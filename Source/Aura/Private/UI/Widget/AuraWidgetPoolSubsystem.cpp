@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UI/Widget/AuraWidgetPoolSubsystem.h"
+#include "UI/Widget/AuraUserWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "Aura/Aura.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Widgets Created"), STAT_AuraPooledWidgetsCreated, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Widget Creations Avoided"), STAT_AuraWidgetCreationsAvoided, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Widgets Dropped"), STAT_AuraPooledWidgetsDropped, STATGROUP_Aura);
+
+void UAuraWidgetPoolSubsystem::Deinitialize()
+{
+	for (TPair<TSubclassOf<UAuraUserWidget>, FAuraWidgetPool>& Pair : Pools)
+	{
+		for (UAuraUserWidget* Widget : Pair.Value.ActiveWidgets)
+		{
+			if (Widget) Widget->OwningPool.Reset();
+		}
+		for (UAuraUserWidget* Widget : Pair.Value.FreeWidgets)
+		{
+			if (Widget) Widget->OwningPool.Reset();
+		}
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+void UAuraWidgetPoolSubsystem::PrewarmWidgets(TSubclassOf<UAuraUserWidget> WidgetClass, int32 Count)
+{
+	if (!WidgetClass) return;
+
+	FAuraWidgetPool& Pool = Pools.FindOrAdd(WidgetClass);
+	const int32 NumToCreate = FMath::Min(Count, MaxFreeWidgetsPerClass) - Pool.FreeWidgets.Num();
+	for (int32 Index = 0; Index < NumToCreate; ++Index)
+	{
+		if (UAuraUserWidget* Widget = CreatePooledWidget(WidgetClass))
+		{
+			Widget->bInPool = true;
+			Pool.FreeWidgets.Add(Widget);
+		}
+	}
+}
+
+UAuraUserWidget* UAuraWidgetPoolSubsystem::AcquireWidget(TSubclassOf<UAuraUserWidget> WidgetClass)
+{
+	if (!WidgetClass) return nullptr;
+
+	FAuraWidgetPool& Pool = Pools.FindOrAdd(WidgetClass);
+	UAuraUserWidget* Widget = nullptr;
+
+	if (Pool.FreeWidgets.Num() > 0)
+	{
+		Widget = Pool.FreeWidgets.Pop(false);
+		++WidgetCreationsAvoided;
+		INC_DWORD_STAT(STAT_AuraWidgetCreationsAvoided);
+	}
+	else if (Pool.ActiveWidgets.Num() >= MaxActiveWidgetsPerClass && Pool.ActiveWidgets.Num() > 0)
+	{
+		// 上限に達しているので一番古いものを画面から外して使い回す
+		Widget = Pool.ActiveWidgets[0];
+		Pool.ActiveWidgets.RemoveAt(0, 1, false);
+		Widget->bInPool = true;
+		Widget->StopAllAnimations();
+		Widget->RemoveFromParent();
+
+		++WidgetsDropped;
+		++WidgetCreationsAvoided;
+		INC_DWORD_STAT(STAT_AuraPooledWidgetsDropped);
+		INC_DWORD_STAT(STAT_AuraWidgetCreationsAvoided);
+	}
+	else
+	{
+		Widget = CreatePooledWidget(WidgetClass);
+	}
+
+	if (!Widget) return nullptr;
+
+	Widget->bInPool = false;
+	Pool.ActiveWidgets.Add(Widget);
+	Widget->WidgetAcquiredFromPool();
+	return Widget;
+}
+
+void UAuraWidgetPoolSubsystem::ReleaseWidget(UAuraUserWidget* Widget)
+{
+	if (!Widget || Widget->bInPool || Widget->OwningPool.Get() != this) return;
+
+	FAuraWidgetPool* Pool = Pools.Find(Widget->GetClass());
+	if (!Pool) return;
+
+	// RemoveFromParent中にアニメーション終了が呼ばれても二重に戻さないよう先にフラグを立てる
+	Widget->bInPool = true;
+	Pool->ActiveWidgets.Remove(Widget);
+	Widget->StopAllAnimations();
+	Widget->RemoveFromParent();
+
+	if (Pool->FreeWidgets.Num() < MaxFreeWidgetsPerClass)
+	{
+		Pool->FreeWidgets.Add(Widget);
+	}
+	else
+	{
+		Widget->OwningPool.Reset();
+	}
+}
+
+UAuraUserWidget* UAuraWidgetPoolSubsystem::CreatePooledWidget(TSubclassOf<UAuraUserWidget> WidgetClass)
+{
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	APlayerController* PC = LocalPlayer ? LocalPlayer->GetPlayerController(GetWorld()) : nullptr;
+	if (!PC) return nullptr;
+
+	UAuraUserWidget* Widget = CreateWidget<UAuraUserWidget>(PC, WidgetClass);
+	if (Widget)
+	{
+		Widget->OwningPool = this;
+		INC_DWORD_STAT(STAT_AuraPooledWidgetsCreated);
+	}
+	return Widget;
+}
@@ -7,38 +7,104 @@
 
 void UAuraMenuWidgetController::BindCallbacksToDependencies()
 {
+	// 購読はMenuOpened/MenuClosed（SubscribeAndSnapshot）でのみ行い、閉じている間は何も購読しない
+}
+
+void UAuraMenuWidgetController::BindAttributeCallbacks()
+{
+	if (HasAttributeBindings()) return;
+
 	UAuraAttributeSet* AS = CastChecked<UAuraAttributeSet>(AttributeSet);
-	check(AttributeInfo);
-	
 	for (TPair<FGameplayTag, FGameplayAttribute(*)()>& Pair : AS->TagsToAttributes)
 	{
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Pair.Value()).AddLambda(
-		[this, Pair](const FOnAttributeChangeData& Data)
+		BindAttributeChange(Pair.Value(),
+			[this, Pair](float NewValue)
 			{
-				BroadcastAttributeInfo(Pair.Key, Pair.Value());
+				BroadcastAttributeValue(Pair.Key, Pair.Value());
 			}
 		);
 	}
-	
+}
+
+void UAuraMenuWidgetController::GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const
+{
+	OutAssets.Add(AttributeInfo.ToSoftObjectPath());
+}
+
+void UAuraMenuWidgetController::MenuOpened()
+{
+	// メニュー本体と各行のウィジェットがそれぞれ呼ぶので、最初の1回だけ処理する
+	if (++OpenCount > 1) return;
+
+	// AttributeInfoは初めて開いた時に読み込む
+	LoadAssets(FSimpleDelegate::CreateUObject(this, &UAuraMenuWidgetController::SubscribeAndSnapshot));
+}
+
+void UAuraMenuWidgetController::MenuClosed()
+{
+	if (OpenCount == 0 || --OpenCount > 0) return;
+
+	UnbindAttributeChanges();
+}
 
+void UAuraMenuWidgetController::SubscribeAndSnapshot()
+{
+	// 読み込み中に閉じられた
+	if (OpenCount == 0) return;
+
+	BindAttributeCallbacks();
+	CacheLegacyAttributeInfos();
+
+	MenuAssetsLoadedDelegate.Broadcast();
+
+	// 開いた時点の値をまとめて通知する
+	BroadcastInitialValues();
+}
+
+void UAuraMenuWidgetController::CacheLegacyAttributeInfos()
+{
+	const UAttributeInfo* Info = AttributeInfo.Get();
+	if (!Info || !LegacyAttributeInfos.IsEmpty()) return;
+
+	for (const FAuraAttributeInfo& Entry : Info->AttributeInformation)
+	{
+		LegacyAttributeInfos.Add(Entry.AttributeTag, Entry);
+	}
 }
 
 void UAuraMenuWidgetController::BroadcastInitialValues()
 {
 	UAuraAttributeSet* AS = CastChecked<UAuraAttributeSet>(AttributeSet);
-	check(AttributeInfo);
 
 	for (auto& Pair : AS->TagsToAttributes)
 	{
-		BroadcastAttributeInfo(Pair.Key, Pair.Value());
+		BroadcastAttributeValue(Pair.Key, Pair.Value());
 	}
 
 }
 
-void UAuraMenuWidgetController::BroadcastAttributeInfo(const FGameplayTag& AttributeTag,
-	const FGameplayAttribute& Attribute) const
+void UAuraMenuWidgetController::BroadcastAttributeValue(const FGameplayTag& AttributeTag,
+	const FGameplayAttribute& Attribute)
+{
+	FAuraAttributeValue Value;
+	Value.AttributeTag = AttributeTag;
+	Value.AttributeValue = Attribute.GetNumericValue(AttributeSet);
+	AttributeValueDelegate.Broadcast(Value);
+
+	// 読み込み時に作ったキャッシュの値だけ更新して渡す（読み込み前は通知しない。読み込み後のスナップショットで届く）
+	if (AttributeInfoDelegate.IsBound())
+	{
+		if (FAuraAttributeInfo* LegacyInfo = LegacyAttributeInfos.Find(AttributeTag))
+		{
+			LegacyInfo->AttributeValue = Value.AttributeValue;
+			AttributeInfoDelegate.Broadcast(*LegacyInfo);
+		}
+	}
+}
+
+const FAuraAttributeInfo& UAuraMenuWidgetController::GetAttributeInfo(const FGameplayTag& AttributeTag) const
 {
-	FAuraAttributeInfo Info = AttributeInfo->FindAttributeInfoForTag(AttributeTag);
-	Info.AttributeValue = Attribute.GetNumericValue(AttributeSet);
-	AttributeInfoDelegate.Broadcast(Info);
+	const UAttributeInfo* Info = AttributeInfo.Get();
+	checkf(Info, TEXT("AttributeInfo is not loaded yet, wait for MenuAssetsLoadedDelegate."));
+	return Info->FindAttributeInfoForTag(AttributeTag, true);
 }
@@ -2,6 +2,16 @@
 
 
 #include "UI/WidgetController/AuraWidgetController.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Aura/Aura.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Attribute Changes"), STAT_AuraWidgetAttributeChanges, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Attribute Broadcasts"), STAT_AuraWidgetAttributeBroadcasts, STATGROUP_Aura);
 
 void UAuraWidgetController::SetWidgetControllerParams(const FWidgetControllerParams& WCParams)
 {
@@ -22,3 +32,137 @@ void UAuraWidgetController::BindCallbacksToDependencies()
 {
 	
 }
+
+void UAuraWidgetController::LoadAssets(FSimpleDelegate OnLoaded, const TArray<FSoftObjectPath>& ExtraAssets)
+{
+	if (bAssetsLoaded)
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	TArray<FSoftObjectPath> Assets = ExtraAssets;
+	GetAssetsToLoad(Assets);
+	Assets.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+
+	// 読み込み中に再度呼ばれた場合は前のリクエストを破棄する
+	if (AssetLoadHandle.IsValid())
+	{
+		AssetLoadHandle->CancelHandle();
+		AssetLoadHandle.Reset();
+	}
+
+	const FStreamableDelegate OnComplete = FStreamableDelegate::CreateWeakLambda(this, [this, OnLoaded]()
+		{
+			bAssetsLoaded = true;
+			OnAssetsLoaded();
+			OnLoaded.ExecuteIfBound();
+		}
+	);
+
+	if (Assets.Num() == 0)
+	{
+		OnComplete.Execute();
+		return;
+	}
+
+	AssetLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Assets, OnComplete);
+}
+
+void UAuraWidgetController::BindAttributeChange(const FGameplayAttribute& Attribute, TFunction<void(float)>&& BroadcastFunc)
+{
+	check(AbilitySystemComponent);
+
+	const int32 SlotIndex = AttributeSlots.AddDefaulted();
+	FAuraAttributeBroadcastSlot& Slot = AttributeSlots[SlotIndex];
+	Slot.Attribute = Attribute;
+	Slot.Broadcast = MoveTemp(BroadcastFunc);
+	Slot.DelegateHandle = AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(
+		this, &UAuraWidgetController::OnAttributeChanged, SlotIndex);
+
+	DirtyAttributeSlots.Add(false);
+}
+
+void UAuraWidgetController::UnbindAttributeChanges()
+{
+	if (AbilitySystemComponent)
+	{
+		for (const FAuraAttributeBroadcastSlot& Slot : AttributeSlots)
+		{
+			AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Slot.Attribute).Remove(Slot.DelegateHandle);
+		}
+	}
+
+	if (bAttributeFlushScheduled)
+	{
+		if (UWorld* World = PlayerController ? PlayerController->GetWorld() : nullptr)
+		{
+			World->GetTimerManager().ClearTimer(AttributeFlushTimer);
+		}
+		bAttributeFlushScheduled = false;
+	}
+
+	AttributeSlots.Reset();
+	DirtyAttributeSlots.Reset();
+	++AttributeSlotsGeneration;
+}
+
+void UAuraWidgetController::OnAttributeChanged(const FOnAttributeChangeData& Data, int32 SlotIndex)
+{
+	INC_DWORD_STAT(STAT_AuraWidgetAttributeChanges);
+
+	// 最新値だけ保持しておく
+	AttributeSlots[SlotIndex].PendingValue = Data.NewValue;
+	DirtyAttributeSlots[SlotIndex] = true;
+
+	ScheduleAttributeFlush();
+}
+
+void UAuraWidgetController::ScheduleAttributeFlush()
+{
+	if (bAttributeFlushScheduled) return;
+
+	UWorld* World = PlayerController ? PlayerController->GetWorld() : nullptr;
+	if (!World)
+	{
+		FlushAttributeChanges();
+		return;
+	}
+
+	bAttributeFlushScheduled = true;
+	if (AttributeBroadcastInterval > 0.f)
+	{
+		World->GetTimerManager().SetTimer(AttributeFlushTimer, this, &UAuraWidgetController::FlushAttributeChanges, AttributeBroadcastInterval, false);
+	}
+	else
+	{
+		AttributeFlushTimer = World->GetTimerManager().SetTimerForNextTick(this, &UAuraWidgetController::FlushAttributeChanges);
+	}
+}
+
+void UAuraWidgetController::FlushAttributeChanges()
+{
+	bAttributeFlushScheduled = false;
+
+	// Blueprintの処理中に変わった属性は次のフラッシュで送るので、先にダーティを手元に移す
+	TBitArray<> DirtySlots = MoveTemp(DirtyAttributeSlots);
+	DirtyAttributeSlots.Init(false, AttributeSlots.Num());
+
+	const uint32 Generation = AttributeSlotsGeneration;
+	for (TConstSetBitIterator<> It(DirtySlots); It; ++It)
+	{
+		FAuraAttributeBroadcastSlot& Slot = AttributeSlots[It.GetIndex()];
+
+		// 前回通知した値と同じならBlueprintは呼ばない
+		if (Slot.bHasBroadcast && Slot.LastBroadcastValue == Slot.PendingValue) continue;
+
+		Slot.LastBroadcastValue = Slot.PendingValue;
+		Slot.bHasBroadcast = true;
+		Slot.Broadcast(Slot.PendingValue);
+
+		INC_DWORD_STAT(STAT_AuraWidgetAttributeBroadcasts);
+
+		// Blueprintがメニューを閉じるなどしてスロットが解除されたら、残りは送らない
+		if (Generation != AttributeSlotsGeneration) return;
+	}
+}
@@ -5,6 +5,10 @@
 
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAttributeSet.h"
+#include "AuraGameplayTags.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Overlay Effect Asset Tags"), STAT_AuraOverlayEffectAssetTags, STATGROUP_Aura);
 
 void UOverlayWidgetController::BroadcastInitialValues()
 {
@@ -21,53 +25,126 @@ void UOverlayWidgetController::BindCallbacksToDependencies()
 {
 	const UAuraAttributeSet* AuraAttributeSet = CastChecked<UAuraAttributeSet>(AttributeSet);
 
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-		AuraAttributeSet->GetHealthAttribute()).AddLambda(
-			[this](const FOnAttributeChangeData& Data)
-			{
-				OnHealthChanged.Broadcast(Data.NewValue);
-			}
-		);
-
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-		AuraAttributeSet->GetMaxHealthAttribute()).AddLambda(
-		[this](const FOnAttributeChangeData& Data)
-			{
-				OnMaxHealthChanged.Broadcast(Data.NewValue);
-			}
-		);
-
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-		AuraAttributeSet->GetManaAttribute()).AddLambda(
-	[this](const FOnAttributeChangeData& Data)
-			{
-				OnManaChanged.Broadcast(Data.NewValue);
-			}
-		);
-
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(
-		AuraAttributeSet->GetMaxManaAttribute()).AddLambda(
-		[this](const FOnAttributeChangeData& Data)
-			{
-				OnMaxManaChanged.Broadcast(Data.NewValue);
-			}
-		);
+	BindAttributeChange(AuraAttributeSet->GetHealthAttribute(),
+		[this](float NewValue)
+		{
+			OnHealthChanged.Broadcast(NewValue);
+		}
+	);
+
+	BindAttributeChange(AuraAttributeSet->GetMaxHealthAttribute(),
+		[this](float NewValue)
+		{
+			OnMaxHealthChanged.Broadcast(NewValue);
+		}
+	);
+
+	BindAttributeChange(AuraAttributeSet->GetManaAttribute(),
+		[this](float NewValue)
+		{
+			OnManaChanged.Broadcast(NewValue);
+		}
+	);
+
+	BindAttributeChange(AuraAttributeSet->GetMaxManaAttribute(),
+		[this](float NewValue)
+		{
+			OnMaxManaChanged.Broadcast(NewValue);
+		}
+	);
+
+	// MessageWidgetDataTableの読み込みが終わっていれば行マップを作る（未完了ならOnAssetsLoadedで作る）
+	BuildMessageWidgetRows();
 
 	Cast<UAuraAbilitySystemComponent>(AbilitySystemComponent)->EffectAssetTags.AddLambda(
 		[this](const FGameplayTagContainer& AssetTags)
 		{
+		   SCOPE_CYCLE_COUNTER(STAT_AuraOverlayEffectAssetTags);
+
+		   const FGameplayTag& MessageTag = FAuraGameplayTags::Get().Message;
 		   for (const FGameplayTag& Tag : AssetTags)
 		   {
-			  FGameplayTag MessageTag = FGameplayTag::RequestGameplayTag(FName("Message"));
-			  if (Tag.MatchesTag(MessageTag))
+			  if (!Tag.MatchesTag(MessageTag)) continue;
+
+			  // 読み込み中は溜めておき、OnAssetsLoadedで通知する
+			  if (!AreAssetsLoaded())
 			  {
-				 FUIWidgetRow* Row = GetDataTableRowByTag<FUIWidgetRow>(MessageWidgetDataTable, Tag);
-				 if (Row)
-				 {
-					MessageWidgetRowDelegate.Broadcast(*Row);
-				 }
+				 PendingMessageTags.Add(Tag);
+				 continue;
 			  }
+			  BroadcastMessageTag(Tag);
 		   }
 		}
 	);
+}
+
+void UOverlayWidgetController::GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const
+{
+	OutAssets.Add(MessageWidgetDataTable.ToSoftObjectPath());
+}
+
+void UOverlayWidgetController::OnAssetsLoaded()
+{
+	BuildMessageWidgetRows();
+
+	if (MessageWidgetDataTable.IsNull() || MessageWidgetDataTable.Get())
+	{
+		for (const FGameplayTag& Tag : PendingMessageTags)
+		{
+			BroadcastMessageTag(Tag);
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load MessageWidgetDataTable [%s], dropping %d messages."),
+			*MessageWidgetDataTable.ToString(), PendingMessageTags.Num());
+	}
+	PendingMessageTags.Empty();
+}
+
+void UOverlayWidgetController::BroadcastMessageTag(const FGameplayTag& Tag) const
+{
+	if (const FUIWidgetRow* const* Row = MessageWidgetRows.Find(Tag))
+	{
+		MessageWidgetRowDelegate.Broadcast(**Row);
+	}
+}
+
+bool UOverlayWidgetController::BuildMessageWidgetRowMap(const UDataTable* DataTable, TMap<FGameplayTag, const FUIWidgetRow*>& OutRows)
+{
+	OutRows.Reset();
+
+	if (!DataTable->GetRowStruct() || !DataTable->GetRowStruct()->IsChildOf(FUIWidgetRow::StaticStruct()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MessageWidgetDataTable [%s] does not use FUIWidgetRow."), *GetNameSafe(DataTable));
+		return false;
+	}
+
+	// 行名 = タグ名（GetDataTableRowByTagと同じ規則）
+	for (const TPair<FName, uint8*>& RowPair : DataTable->GetRowMap())
+	{
+		const FUIWidgetRow* Row = reinterpret_cast<const FUIWidgetRow*>(RowPair.Value);
+		const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(RowPair.Key, false);
+		if (Tag.IsValid())
+		{
+			OutRows.Add(Tag, Row);
+		}
+	}
+	return true;
+}
+
+void UOverlayWidgetController::BuildMessageWidgetRows()
+{
+	MessageWidgetRows.Reset();
+
+	UDataTable* DataTable = MessageWidgetDataTable.Get();
+	if (!DataTable || !BuildMessageWidgetRowMap(DataTable, MessageWidgetRows)) return;
+
+#if WITH_EDITOR
+	// エディタでDataTableが編集されたら行ポインタを作り直す
+	if (!DataTable->OnDataTableChanged().IsBoundToObject(this))
+	{
+		DataTable->OnDataTableChanged().AddUObject(this, &UOverlayWidgetController::BuildMessageWidgetRows);
+	}
+#endif
 }
\ No newline at end of file
@@ -4,9 +4,46 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "AuraGameplayTags.h"
 #include "AuraAbilitySystemComponent.generated.h"
 
+class UAuraAbilitySet;
+
 DECLARE_MULTICAST_DELEGATE_OneParam(FEffectAssetTags, const FGameplayTagContainer& /*AssetTags*/)
+DECLARE_MULTICAST_DELEGATE_OneParam(FAbilityGiven, const FGameplayAbilitySpec& /*AbilitySpec*/)
+
+// Ability Specごとの入力状態
+enum class EAuraAbilityInputPhase : uint8
+{
+	Released,
+	Pressed,
+	Held
+};
+
+struct FAuraAbilityInputState
+{
+	EAuraAbilityInputPhase Phase = EAuraAbilityInputPhase::Released;
+
+	// この押下で有効化リクエストを送信済みか
+	bool bActivationRequested = false;
+
+	// この押下でAbilityが有効化されたか
+	bool bActivated = false;
+
+	// 失敗・拒否された回数（再試行間隔の計算用）
+	int32 FailedAttempts = 0;
+
+	// 次に再試行できるワールド時刻
+	double NextRetryTime = 0.0;
+};
+
+// サーバーが受け取ったAbility有効化RPCの集計（接続ごと＝ASCごと）
+struct FAuraActivationRPCStats
+{
+	int32 Received = 0;
+	int32 Duplicate = 0;
+	int32 Rejected = 0;
+};
 
 /**
  * 
@@ -21,16 +58,67 @@ public:
 
 	FEffectAssetTags EffectAssetTags;
 
-	void AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>> StartupAbilities);
+	// GiveAbility・GiveAbilitySetなどでSpecが追加されたとき（サーバーでは付与時、クライアントでは複製時）
+	FAbilityGiven AbilityGivenDelegate;
+
+	void AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>>& StartupAbilities);
+
+	// AbilitySetの共有Specテンプレートをコピーして付与する（Specの構築はテンプレート作成時の1回だけ）
+	void GiveAbilitySet(const UAuraAbilitySet* AbilitySet);
 
+	void AbilityInputTagPressed(const FGameplayTag& InputTag);
 	void AbilityInputTagHeld(const FGameplayTag& InputTag);
 	void AbilityInputTagReleased(const FGameplayTag& InputTag);
 
+	const FAuraActivationRPCStats& GetActivationRPCStats() const { return ActivationRPCStats; }
+
+	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
+
+	// 所持タグ（親タグを含む）のうちネイティブタグのビットセット。HasMatchingGameplayTagの代わりに使う
+	FAuraNativeTagBits GetOwnedNativeTagBits() const { return OwnedNativeTagBits; }
+	bool HasNativeTag(EAuraNativeTag Tag) const { return (OwnedNativeTagBits & AuraNativeTagBit(Tag)) != 0; }
+	bool HasAnyNativeTags(FAuraNativeTagBits Mask) const { return (OwnedNativeTagBits & Mask) != 0; }
+	bool HasAllNativeTags(FAuraNativeTagBits Mask) const { return (OwnedNativeTagBits & Mask) == Mask; }
+
 protected:
-	UFUNCTION(Client, Reliable)
-	void ClientEffectApplied(
+	void EffectApplied(
 		UAbilitySystemComponent* AbilitySystemComponent,
 		const FGameplayEffectSpec& EffectSpec,
 		FActiveGameplayEffectHandle ActiveEffectHandle
 	);
+
+	// 1フレーム分のMessageタグ（ネットインデックス）をまとめて送る
+	UFUNCTION(Client, Unreliable)
+	void ClientMessageTagsApplied(const TArray<uint16>& MessageTagNetIndices);
+
+	virtual void InternalServerTryActivateAbility(FGameplayAbilitySpecHandle AbilityToActivate, bool InputPressed, const FPredictionKey& PredictionKey, const FGameplayEventData* TriggerEventData) override;
+	virtual void ClientActivateAbilityFailed_Implementation(FGameplayAbilitySpecHandle AbilityToActivate, int16 PredictionKey) override;
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+
+	// 失敗・拒否後の最初の再試行までの秒数（失敗するたびに倍増）
+	UPROPERTY(EditAnywhere, Category = "Input")
+	float ActivationRetryDelay = 0.1f;
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	float MaxActivationRetryDelay = 1.f;
+
+private:
+	void OnOwnedTagCountChanged(const FGameplayTag Tag, int32 NewCount);
+
+	FAuraNativeTagBits OwnedNativeTagBits = 0;
+
+	void FlushPendingMessageTags();
+
+	TArray<uint16> PendingMessageTagNetIndices;
+
+	void TryActivateAbilityFromInput(FGameplayAbilitySpec& AbilitySpec, FAuraAbilityInputState& InputState);
+	void BackOffActivation(FAuraAbilityInputState& InputState);
+
+	TMap<FGameplayAbilitySpecHandle, FAuraAbilityInputState> AbilityInputStates;
+
+	FAuraActivationRPCStats ActivationRPCStats;
+
+	// InternalServerTryActivateAbility中に有効化されたか
+	FGameplayAbilitySpecHandle ServerActivatingHandle;
+	bool bServerActivationSucceeded = false;
 };
@@ -5,13 +5,34 @@
 #include "CoreMinimal.h"
 #include "AttributeSet.h"
 #include "AbilitySystemComponent.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "AuraAttributeSet.generated.h"
 
+// Setter / Initterで値を書き換えた時にプッシュモデルのダーティフラグを立てる
+#define AURA_ATTRIBUTE_VALUE_SETTER(ClassName, PropertyName) \
+		FORCEINLINE void Set##PropertyName(float NewVal) \
+		{ \
+			UAbilitySystemComponent* AbilityComp = GetOwningAbilitySystemComponent(); \
+			if (ensure(AbilityComp)) \
+			{ \
+				AbilityComp->SetNumericAttributeBase(Get##PropertyName##Attribute(), NewVal); \
+			} \
+			MARK_PROPERTY_DIRTY_FROM_NAME(ClassName, PropertyName, this); \
+		}
+
+#define AURA_ATTRIBUTE_VALUE_INITTER(ClassName, PropertyName) \
+		FORCEINLINE void Init##PropertyName(float NewVal) \
+		{ \
+			PropertyName.SetBaseValue(NewVal); \
+			PropertyName.SetCurrentValue(NewVal); \
+			MARK_PROPERTY_DIRTY_FROM_NAME(ClassName, PropertyName, this); \
+		}
+
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
 		GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
 		GAMEPLAYATTRIBUTE_VALUE_GETTER(PropertyName) \
-		GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
-		GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
+		AURA_ATTRIBUTE_VALUE_SETTER(ClassName, PropertyName) \
+		AURA_ATTRIBUTE_VALUE_INITTER(ClassName, PropertyName)
 
 /**
  * 
@@ -66,6 +87,8 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
 
 	TMap<FGameplayTag, TStaticFuncPtr<FGameplayAttribute()>> TagsToAttributes;
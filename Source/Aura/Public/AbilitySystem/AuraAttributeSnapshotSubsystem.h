@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraAttributeSnapshotSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayEffect;
+
+// 初期値GEの組み合わせとレベル（キャラクタークラスごとの設定はこの組み合わせで決まる）
+struct FAuraAttributeSnapshotKey
+{
+	TObjectKey<UClass> PrimaryEffect;
+	TObjectKey<UClass> SecondaryEffect;
+	TObjectKey<UClass> VitalEffect;
+	int32 Level = 1;
+
+	bool operator==(const FAuraAttributeSnapshotKey& Other) const
+	{
+		return PrimaryEffect == Other.PrimaryEffect && SecondaryEffect == Other.SecondaryEffect &&
+			VitalEffect == Other.VitalEffect && Level == Other.Level;
+	}
+
+	friend uint32 GetTypeHash(const FAuraAttributeSnapshotKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.PrimaryEffect), GetTypeHash(Key.SecondaryEffect));
+		Hash = HashCombine(Hash, GetTypeHash(Key.VitalEffect));
+		return HashCombine(Hash, GetTypeHash(Key.Level));
+	}
+};
+
+// 初期化後のBase値（PrimaryとVitalのGEが変更する属性のみ）
+struct FAuraAttributeSnapshot
+{
+	// PrimaryがAuraCombatData.binにベイク済みならBase値は持たず、そちらから設定する
+	bool bPrimaryFromCombatData = false;
+	TArray<TPair<FGameplayAttribute, float>> PrimaryBaseValues;
+	TArray<TPair<FGameplayAttribute, float>> VitalBaseValues;
+};
+
+/**
+ * 初期値GEの適用結果を (GEの組み合わせ, レベル) ごとにキャッシュし、2体目以降はBase値を直接設定する
+ */
+UCLASS()
+class AURA_API UAuraAttributeSnapshotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsEnabled();
+
+	const FAuraAttributeSnapshot* FindSnapshot(const FAuraAttributeSnapshotKey& Key) const { return Snapshots.Find(Key); }
+
+	// 通常の初期化が終わったASCから、PrimaryとVitalのGEが変更した属性のBase値を記録する
+	void CaptureSnapshot(const FAuraAttributeSnapshotKey& Key, const UAbilitySystemComponent* ASC);
+
+	// PrimaryのBase値をまとめて設定 -> Secondary（Infinite）を適用 -> VitalのBase値を設定
+	void ApplySnapshot(const FAuraAttributeSnapshot& Snapshot, const FAuraAttributeSnapshotKey& Key, UAbilitySystemComponent* ASC, TFunctionRef<void()> ApplySecondaryEffect) const;
+
+private:
+	TMap<FAuraAttributeSnapshotKey, FAuraAttributeSnapshot> Snapshots;
+};
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraTagReplicationProfiler.generated.h"
+
+// Shipping/Testビルドでは記録処理ごと消える
+#define AURA_TAG_REPLICATION_PROFILER !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+/**
+ * Effect Spec・Ability Specと共に実際にシリアライズされるタグ（動的タグ）を、送信先の接続ごとに数える開発用プロファイラ
+ * （アセットタグはGEのCDOから参照されるので送られず、MessageタグはNetIndexのまま送るのでCommonlyReplicatedTagsの影響を受けない）
+ * Aura.TagReplication.Enable 1 で記録を開始し、Aura.TagReplication.WriteReport でSaved/Profiling/に
+ * CommonlyReplicatedTagsとNetIndexFirstBitSegmentの推奨値を書き出す
+ */
+UCLASS()
+class AURA_API UAuraTagReplicationProfiler : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// Ownerのコネクションに送られるタグとして記録する（コネクションが無ければ送られないので記録しない）
+	static void RecordTags(const AActor* Owner, const FGameplayTagContainer& Tags);
+	// 全クライアントに送られるタグとして、接続ごとに記録する
+	static void RecordTagsForAllConnections(const UWorld* World, const FGameplayTagContainer& Tags);
+
+	void Reset();
+	bool WriteReport(FString& OutFilename) const;
+
+private:
+	void RecordTagsInternal(const UNetConnection* Connection, const FGameplayTagContainer& Tags);
+
+	// コネクション名 -> タグ -> 回数
+	TMap<FString, TMap<FGameplayTag, int64>> ConnectionTagCounts;
+	TMap<FGameplayTag, int64> TotalTagCounts;
+};
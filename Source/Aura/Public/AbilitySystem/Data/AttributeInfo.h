@@ -22,6 +22,7 @@ struct FAuraAttributeInfo
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	FText AttributeDescription = FText();
 
+	// AttributeInfoDelegate（既存のBlueprint用）で通知する時だけ設定される
 	UPROPERTY(BlueprintReadOnly)
 	float AttributeValue = 0.f;
 };
@@ -35,10 +36,20 @@ class AURA_API UAttributeInfo : public UDataAsset
 	GENERATED_BODY()
 	
 public:
-	FAuraAttributeInfo FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound = false) const;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// 見つからない場合は空の行を返す
+	const FAuraAttributeInfo& FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound = false) const;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TArray<FAuraAttributeInfo> AttributeInformation;
 	
-	
+private:
+	void BuildIndex();
+
+	// AttributeTag -> AttributeInformation のインデックス（完全一致）
+	TMap<FGameplayTag, int32> AttributeIndexByTag;
 };
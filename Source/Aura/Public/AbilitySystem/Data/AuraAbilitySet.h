@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpec.h"
+#include "GameplayTagContainer.h"
+#include "Engine/DataAsset.h"
+#include "AuraAbilitySet.generated.h"
+
+class UGameplayAbility;
+
+USTRUCT(BlueprintType)
+struct FAuraAbilitySetEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	TSubclassOf<UGameplayAbility> Ability;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	int32 AbilityLevel = 1;
+
+	// 空の場合はUAuraGameplayAbility::StartupInputTagを使う
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (Categories = "InputTag"))
+	FGameplayTag InputTag = FGameplayTag();
+};
+
+/**
+ * 付与するAbilityの一覧。Specのテンプレートを一度だけ作り、全キャラクターで共有する
+ */
+UCLASS(BlueprintType)
+class AURA_API UAuraAbilitySet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	const TArray<FGameplayAbilitySpec>& GetSpecTemplates() const;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities")
+	TArray<FAuraAbilitySetEntry> GrantedAbilities;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	void BuildSpecTemplates() const;
+
+	mutable TArray<FGameplayAbilitySpec> SpecTemplates;
+	mutable bool bSpecTemplatesBuilt = false;
+};
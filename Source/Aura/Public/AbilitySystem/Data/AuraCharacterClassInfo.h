@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "AuraCharacterClassInfo.generated.h"
+
+class UGameplayEffect;
+class UAuraAbilitySet;
+class UTexture2D;
+
+/**
+ * キャラクタークラスごとの初期値。中身はソフト参照で、UAuraAssetManagerがバンドル単位で先読みする
+ */
+UCLASS(BlueprintType)
+class AURA_API UAuraCharacterClassInfo : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes", meta = (AssetBundles = "Startup"))
+	TSoftClassPtr<UGameplayEffect> PrimaryAttributes;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes", meta = (AssetBundles = "Startup"))
+	TSoftClassPtr<UGameplayEffect> SecondaryAttributes;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Attributes", meta = (AssetBundles = "Startup"))
+	TSoftClassPtr<UGameplayEffect> VitalAttributes;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Abilities", meta = (AssetBundles = "Combat"))
+	TSoftObjectPtr<UAuraAbilitySet> AbilitySet;
+
+	UPROPERTY(EditDefaultsOnly, Category = "UI", meta = (AssetBundles = "UI"))
+	TSoftObjectPtr<UTexture2D> Portrait;
+};
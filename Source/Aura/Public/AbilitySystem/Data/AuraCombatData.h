@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuraGameplayTags.h"
+#include "UObject/ObjectKey.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UAbilitySystemComponent;
+class UGameplayEffect;
+
+/**
+ * ベイク済み戦闘データ（AuraCombatData.bin）のレイアウト
+ * AuraBakeCombatDataコマンドレット（AuraEditorモジュール）で書き出し、起動時にメモリマップしてそのまま参照する（デシリアライズしない）
+ * 対象はスポーンごとにサーバーで評価される属性の初期値GEのみ。AttributeInfo・メッセージ行はUIアセット（FText・ウィジェット）が
+ * 必要でサーバーでは読み込まず、MMCの係数はCDOの定数なので、どちらもベイクしない
+ * レイアウトを変えたらAuraCombatDataVersionを上げる
+ */
+constexpr uint32 AuraCombatDataMagic = 0x44434155; // "AUCD"
+constexpr uint32 AuraCombatDataVersion = 2;
+
+// 初期値GE（静的なOverrideのみのInstant GE）をレベルごとに評価した値。(EffectHash, Level) でソート済み
+struct FAuraBakedAttributeDefaults
+{
+	uint64 EffectHash = 0;
+	uint64 SourceHash = 0;		// ベイク時のGEの内容（HashEffectSource）。実行時と一致しない行は使わない
+	int32 Level = 0;
+	uint32 Padding = 0;
+	FAuraNativeTagBits ValidMask = 0;
+	float Values[AuraNativeTagCount] = {};
+};
+
+struct FAuraCombatDataHeader
+{
+	uint32 Magic = AuraCombatDataMagic;
+	uint32 Version = AuraCombatDataVersion;
+	uint32 NativeTagCount = AuraNativeTagCount;
+	uint32 Padding = 0;
+	uint64 FileSize = 0;
+
+	uint64 AttributeDefaultsOffset = 0;
+	uint64 NumAttributeDefaults = 0;
+};
+
+/**
+ * AuraCombatData.binの読み取り専用ビュー（シングルトン、ゲームスレッドからのみ使う）
+ * ファイルが無い・バージョンが違う場合はIsLoaded()がfalseになり、呼び出し側は従来通りGEを適用する
+ */
+class AURA_API FAuraCombatData
+{
+public:
+	static const FAuraCombatData& Get() { return CombatData; }
+	static void Initialize();
+	static FString GetDefaultFilename();
+
+	// 名前（クラスパス）からベイク時と同じハッシュを作る
+	static uint64 HashName(FStringView Name);
+
+	// GEの全Modifier（属性・演算・レベルでの値）のハッシュ。すべて静的なOverrideでなければfalseを返す
+	static bool HashEffectSource(const UGameplayEffect* Effect, int32 Level, uint64& OutHash);
+
+	~FAuraCombatData();
+
+	bool IsLoaded() const { return Header != nullptr; }
+
+	// GEを適用せずにBase値を設定してよい行を返す（GEがベイク後に変更されていればnullptr）
+	const FAuraBakedAttributeDefaults* FindAttributeDefaults(const UClass* EffectClass, int32 Level) const;
+
+	// ベイク済みの行があればASCのBase値に設定してtrueを返す（falseなら呼び出し側でGEを適用する）
+	bool ApplyAttributeDefaults(const UClass* EffectClass, int32 Level, UAbilitySystemComponent* ASC) const;
+
+private:
+	bool Load(const FString& Filename);
+	bool Validate();
+
+	static FAuraCombatData CombatData;
+
+	// RegionはHandleより先に破棄する（宣言の逆順）
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	// メモリマップできないプラットフォーム用
+	TArray64<uint8> FallbackData;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	const FAuraCombatDataHeader* Header = nullptr;
+
+	// (GE, レベル) ごとのSourceHashの照合結果（初回の検索時に1回だけ計算する）
+	mutable TMap<TPair<TObjectKey<UClass>, int32>, bool> SourceHashMatches;
+};
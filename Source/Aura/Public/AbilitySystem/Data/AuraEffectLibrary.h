@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Engine/DataAsset.h"
+#include "AuraEffectLibrary.generated.h"
+
+class UGameplayEffect;
+
+/**
+ * タグで引けるGameplayEffectの一覧（ダメージ・回復・バフなど）
+ */
+UCLASS(BlueprintType)
+class AURA_API UAuraEffectLibrary : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// 読み込まれていない場合はnullptr
+	TSubclassOf<UGameplayEffect> FindEffectForTag(const FGameplayTag& EffectTag) const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Effects", meta = (AssetBundles = "Combat"))
+	TMap<FGameplayTag, TSoftClassPtr<UGameplayEffect>> Effects;
+};
@@ -19,6 +19,16 @@ public:
 
 	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
 
+	// Base + PerVigor * Vigor + PerLevel * Level
+	UPROPERTY(EditDefaultsOnly, Category = "Formula")
+	float Base = 80.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Formula")
+	float PerVigor = 2.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Formula")
+	float PerLevel = 10.f;
+
 private:
 	FGameplayEffectAttributeCaptureDefinition VigorDef;
 };
@@ -19,6 +19,16 @@ public:
 
 	virtual float CalculateBaseMagnitude_Implementation(const FGameplayEffectSpec& Spec) const override;
 
+	// Base + PerIntelligence * Intelligence + PerLevel * Level
+	UPROPERTY(EditDefaultsOnly, Category = "Formula")
+	float Base = 50.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Formula")
+	float PerIntelligence = 2.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Formula")
+	float PerLevel = 15.f;
+
 private:
 	FGameplayEffectAttributeCaptureDefinition IntelligenceDef;
 	
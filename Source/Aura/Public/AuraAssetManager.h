@@ -6,6 +6,8 @@
 #include "Engine/AssetManager.h"
 #include "AuraAssetManager.generated.h"
 
+struct FStreamableHandle;
+
 /**
  * 
  */
@@ -16,9 +18,29 @@ class AURA_API UAuraAssetManager : public UAssetManager
 public:
 	
 	static UAuraAssetManager& Get();
+
+	// PrimaryAssetType（ネイティブクラス名と同じ。DefaultGame.iniのPrimaryAssetTypesToScanと合わせる）
+	static const FPrimaryAssetType AbilitySetType;
+	static const FPrimaryAssetType CharacterClassType;
+	static const FPrimaryAssetType EffectLibraryType;
+
+	// AssetBundles
+	static const FName StartupBundle;
+	static const FName CombatBundle;
+	static const FName UIBundle;
+
+	// Startup・Combat・UIバンドルをバックグラウンドで読み込む（ロード画面中に呼ばれる）
+	void PreloadGameplayBundles();
+
 protected:
 
 	virtual void StartInitialLoading() override;
-	
-	
+
+private:
+	void OnPreLoadMap(const FString& MapName);
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void OnGameplayBundlesLoaded();
+
+	TSharedPtr<FStreamableHandle> GameplayBundlesHandle;
+	double GameplayBundlesRequestTime = 0.0;
 };
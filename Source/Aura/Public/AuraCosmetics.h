@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Misc/App.h"
+
+// 専用サーバー（AuraServerターゲット）では見た目だけの処理（HUD・敵のハイライト）をコンパイルしない
+#define AURA_WITH_COSMETICS !UE_SERVER
+
+// 見た目だけの処理を実行するか（通常ビルドの専用サーバーや -nullrhi でも実行しない）
+inline bool AuraShouldRunCosmetics(const AActor* Actor)
+{
+#if AURA_WITH_COSMETICS
+	return FApp::CanEverRender() && !Actor->IsNetMode(NM_DedicatedServer);
+#else
+	return false;
+#endif
+}
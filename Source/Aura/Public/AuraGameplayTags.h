@@ -5,13 +5,57 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 
+/**
+ * ネイティブタグのインデックス（FAuraGameplayTagsのメンバーと同じ順番）
+ * ビットセット（FAuraNativeTagBits）のビット位置として使う
+ */
+enum class EAuraNativeTag : uint8
+{
+	Attributes_Primary_Strength,
+	Attributes_Primary_Intelligence,
+	Attributes_Primary_Resilience,
+	Attributes_Primary_Vigor,
+
+	Attributes_Secondary_Armor,
+	Attributes_Secondary_ArmorPenetration,
+	Attributes_Secondary_BlockChance,
+	Attributes_Secondary_CriticalHitChance,
+	Attributes_Secondary_CriticalHitDamage,
+	Attributes_Secondary_CriticalHitResistance,
+	Attributes_Secondary_HealthRegeneration,
+	Attributes_Secondary_ManaRegeneration,
+	Attributes_Secondary_MaxHealth,
+	Attributes_Secondary_MaxMana,
+
+	InputTag_LMB,
+	InputTag_RMB,
+	InputTag_1,
+	InputTag_2,
+	InputTag_3,
+	InputTag_4,
+
+	Message,
+
+	MAX
+};
+
+constexpr int32 AuraNativeTagCount = static_cast<int32>(EAuraNativeTag::MAX);
+
+using FAuraNativeTagBits = uint64;
+static_assert(AuraNativeTagCount <= 64, "FAuraNativeTagBits has room for 64 native tags");
+
+constexpr FAuraNativeTagBits AuraNativeTagBit(EAuraNativeTag Tag)
+{
+	return FAuraNativeTagBits(1) << static_cast<uint8>(Tag);
+}
+
 /**
  * AuraGameplayTags
  *
  * Singleton containing native Gameplay Tags
  */
 
-struct FAuraGameplayTags
+struct AURA_API FAuraGameplayTags
 {
 public:
 	static const FAuraGameplayTags& Get() {return GameplayTags;}
@@ -40,9 +84,20 @@ public:
 	FGameplayTag InputTag_3;
 	FGameplayTag InputTag_4;
 
+	FGameplayTag Message;
+
+	const FGameplayTag& GetNativeTag(EAuraNativeTag Tag) const { return NativeTags[static_cast<uint8>(Tag)]; }
+	const EAuraNativeTag* FindNativeTag(const FGameplayTag& Tag) const { return NativeTagIndices.Find(Tag); }
+
+	// Tag自身と親タグのうち、ネイティブタグのビット（MatchesTagと同じ判定）
+	FAuraNativeTagBits GetMatchBits(const FGameplayTag& Tag) const;
+	FAuraNativeTagBits GetMatchBits(const FGameplayTagContainer& Container) const;
 
 protected:
 
 private:
 	static FAuraGameplayTags GameplayTags;
+
+	TStaticArray<FGameplayTag, AuraNativeTagCount> NativeTags;
+	TMap<FGameplayTag, EAuraNativeTag> NativeTagIndices;
 };
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraSpatialHashSubsystem.generated.h"
+
+enum class EAuraSpatialCategory : uint8
+{
+	None = 0,
+	Combatant = 1 << 0,		// ICombatInterfaceを実装したアクター
+	EffectActor = 1 << 1,	// AAuraEffectActor
+	All = 0xFF
+};
+ENUM_CLASS_FLAGS(EAuraSpatialCategory);
+
+struct FAuraSpatialHashEntry
+{
+	// ワーカースレッドではLocation/Radiusだけを使い、Actorはゲームスレッドで解決する
+	TWeakObjectPtr<AActor> Actor;
+	FVector Location = FVector::ZeroVector;
+	float Radius = 0.f;
+	EAuraSpatialCategory Category = EAuraSpatialCategory::None;
+};
+
+/**
+ * ある時点のグリッドの読み取り専用コピー（セルごとに連続して並べる）
+ * 公開後は変更されないので、どのスレッドからでも問い合わせできる
+ */
+struct AURA_API FAuraSpatialHashSnapshot
+{
+	float CellSize = 500.f;
+	TArray<FAuraSpatialHashEntry> Entries;
+	TMap<FIntPoint, TPair<int32, int32>> CellRanges;	// 先頭インデックス, 数
+
+	// 中心からRadius以内（エントリの半径を含む）
+	void QueryRadius(const FVector& Center, float Radius, EAuraSpatialCategory CategoryMask, TArray<FAuraSpatialHashEntry>& OutEntries) const;
+
+	// Origin から Direction（正規化済み）方向に半角HalfAngleDegrees・距離Range以内
+	void QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, EAuraSpatialCategory CategoryMask, TArray<FAuraSpatialHashEntry>& OutEntries) const;
+
+	// 近い順にCount個まで（MaxRadius以内）
+	void QueryNearest(const FVector& Location, int32 Count, float MaxRadius, EAuraSpatialCategory CategoryMask, TArray<FAuraSpatialHashEntry>& OutEntries) const;
+
+private:
+	FIntPoint ToCell(const FVector& Location) const;
+	template<typename FunctionType>
+	void ForEachInCellRange(const FIntPoint& MinCell, const FIntPoint& MaxCell, FunctionType&& Function) const;
+};
+
+/**
+ * 戦闘アクターとエフェクトアクターの一様グリッド（物理シーンを使わない近傍検索）
+ * - ルートコンポーネントのTransformUpdatedで移動を検知し、Tickで移動したものだけセルを更新する
+ * - 更新後にスナップショットを作り、ダブルバッファで公開する（GetSnapshotはどのスレッドからでも呼べる）
+ */
+UCLASS(Config = Game)
+class AURA_API UAuraSpatialHashSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	using FSnapshotPtr = TSharedPtr<const FAuraSpatialHashSnapshot, ESPMode::ThreadSafe>;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterActor(AActor* Actor, EAuraSpatialCategory Category);
+	void UnregisterActor(AActor* Actor);
+
+	// 移動したアクターのセルを更新し、新しいスナップショットを公開する（通常はTickで行う）
+	void FlushPendingUpdates();
+
+	// 最後に公開されたスナップショット（スレッドセーフ）
+	FSnapshotPtr GetSnapshot() const;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|SpatialHash")
+	float CellSize = 500.f;
+
+private:
+	struct FLiveEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		float Radius = 0.f;
+		EAuraSpatialCategory Category = EAuraSpatialCategory::None;
+		FDelegateHandle TransformUpdatedHandle;
+		bool bDirty = false;
+	};
+
+	void OnTransformUpdated(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport, int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+	void PublishSnapshot();
+	FIntPoint ToCell(const FVector& Location) const;
+
+	// ゲームスレッドでのみ触るグリッド
+	TArray<FLiveEntry> LiveEntries;
+	TArray<int32> FreeEntryIndices;
+	TArray<int32> DirtyEntryIndices;
+	TMap<TObjectKey<AActor>, int32> EntryIndexByActor;
+	TMap<FIntPoint, TArray<int32>> LiveCells;
+	bool bSnapshotDirty = true;
+
+	// 公開中とその前のスナップショット。前のものを誰も参照していなければ次の書き込みに再利用する
+	mutable FCriticalSection SnapshotLock;
+	TSharedPtr<FAuraSpatialHashSnapshot, ESPMode::ThreadSafe> PublishedSnapshot;
+	TSharedPtr<FAuraSpatialHashSnapshot, ESPMode::ThreadSafe> BackSnapshot;
+};
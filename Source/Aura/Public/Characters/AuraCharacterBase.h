@@ -12,6 +12,8 @@ class UAbilitySystemComponent;
 class UAttributeSet;
 class UGameplayEffect;
 class UGameplayAbility;
+class UAuraAbilitySet;
+class UAuraCharacterClassInfo;
 
 UCLASS(Abstract)
 class AURA_API AAuraCharacterBase : public ACharacter, public IAbilitySystemInterface, public ICombatInterface
@@ -26,6 +28,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditAnywhere, Category = "Combat")
 	TObjectPtr<USkeletalMeshComponent> Weapon;
@@ -41,6 +44,10 @@ protected:
 
 	virtual void InitAbilityActorInfo();
 
+	// 設定されている場合はこちらの初期値を使う（下のDefault*Attributes/AbilitySetより優先）
+	UPROPERTY(EditAnywhere, Category = "Character Class Defaults")
+	TObjectPtr<UAuraCharacterClassInfo> CharacterClassInfo;
+
 	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Attributes")
 	TSubclassOf<UGameplayEffect> DefaultPrimaryAttributes;
 
@@ -51,7 +58,14 @@ protected:
 	TSubclassOf<UGameplayEffect> DefaultVitalAttributes;
 
 	void ApplyEffectToSelf(TSubclassOf<UGameplayEffect> GameplayEffectClass, float Level) const;
-	void InitializeDefaultAttributes() const;
+	// 2体目以降は (GEの組み合わせ, レベル) ごとのスナップショットからBase値を設定する
+	void InitializeDefaultAttributes();
+
+	// プールから再利用する際などにHealth/Manaだけを初期値に戻す
+	void ResetVitalAttributes() const;
+
+	// CharacterClassInfoが設定されていればそちら、なければDefault*Attributesを返す
+	void GetDefaultAttributeEffects(TSubclassOf<UGameplayEffect>& OutPrimary, TSubclassOf<UGameplayEffect>& OutSecondary, TSubclassOf<UGameplayEffect>& OutVital) const;
 
 	void AddCharacterAbilities();
 
@@ -60,4 +74,8 @@ protected:
 private:
 	UPROPERTY(EditAnywhere, Category = "Abilities")
 	TArray<TSubclassOf<UGameplayAbility>> StartupAbilities;
+
+	// 同じクラスのキャラクター間でSpecテンプレートを共有する
+	UPROPERTY(EditAnywhere, Category = "Abilities")
+	TObjectPtr<UAuraAbilitySet> AbilitySet;
 };
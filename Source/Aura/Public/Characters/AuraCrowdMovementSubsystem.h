@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraCrowdMovementSubsystem.generated.h"
+
+class AAuraEnemy;
+
+// 群衆移動の敵のレプリケーション用（位置1cm精度・Yaw 16bit）
+USTRUCT()
+struct FAuraCrowdNetState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	// 変わったらクライアントは補間せずに位置を合わせる（プールからの再出現など）
+	UPROPERTY()
+	uint8 TeleportCount = 0;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAuraCrowdNetState> : public TStructOpsTypeTraitsBase2<FAuraCrowdNetState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * bUseCrowdMovementの敵をCharacterMovementComponentを使わずにまとめて動かす
+ * サーバー: 最も近いプレイヤーへ向かう速度 + 分離力 -> ナビメッシュに投影して位置を直接設定し、低頻度で圧縮した位置・Yawを送る
+ * クライアント: 受け取った位置・Yawの間を補間する
+ */
+UCLASS()
+class AURA_API UAuraCrowdMovementSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterMember(AAuraEnemy* Enemy);
+	void UnregisterMember(AAuraEnemy* Enemy);
+
+	int32 GetNumMembers() const { return Members.Num(); }
+
+	// 位置・Yawを送る頻度（AAuraEnemyのNetUpdateFrequencyにも使う）
+	static float GetNetSendRate();
+
+private:
+	void SimulateMembers(float DeltaTime);
+	void SendMemberStates();
+	void InterpolateMembers(float DeltaTime);
+
+	// Members/Velocitiesは同じインデックス
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraEnemy>> Members;
+	TArray<FVector> Velocities;
+
+	// Tickごとに使い回す作業領域
+	TArray<FVector> Locations;
+	TArray<FVector> NewLocations;
+	TArray<FVector> TargetLocations;
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<8>>> Grid;
+
+	float TimeSinceSend = 0.f;
+	uint32 FrameCounter = 0;
+};
@@ -5,8 +5,12 @@
 #include "CoreMinimal.h"
 #include "Characters/AuraCharacterBase.h"
 #include "Interaction/EnemyInterface.h"
+#include "Characters/AuraSignificanceSubsystem.h"
+#include "Characters/AuraCrowdMovementSubsystem.h"
 #include "AuraEnemy.generated.h"
 
+class UAuraEnemySpawnDirector;
+
 /**
  * 
  */
@@ -17,13 +21,33 @@ class AURA_API AAuraEnemy : public AAuraCharacterBase, public IEnemyInterface
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void InitAbilityActorInfo() override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Class Defaults")
 	int32 Level = 1;
+
+	// 近い順。描画されていない敵は1つ下のバケットを使う
+	UPROPERTY(EditDefaultsOnly, Category = "Significance")
+	TArray<FAuraSignificanceBucket> SignificanceBuckets;
+
+	// trueの場合はCharacterMovementComponentを使わず、UAuraCrowdMovementSubsystemでまとめて動かす（近接の群れ向け）
+	UPROPERTY(EditDefaultsOnly, Category = "Crowd")
+	bool bUseCrowdMovement = false;
+
+	// 最も近いプレイヤーとの距離がこれ以下になったら止まる
+	UPROPERTY(EditDefaultsOnly, Category = "Crowd", meta = (EditCondition = "bUseCrowdMovement"))
+	float CrowdAcceptanceRadius = 150.f;
+
+	UPROPERTY(ReplicatedUsing = OnRep_CrowdNetState)
+	FAuraCrowdNetState CrowdNetState;
+
+	UFUNCTION()
+	void OnRep_CrowdNetState(const FAuraCrowdNetState& OldCrowdNetState);
 	
 public:
 	AAuraEnemy();
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	//Enemy Interface
 	virtual void HighlightActor() override;
@@ -34,5 +58,38 @@ public:
 	virtual int32 GetPlayerLevel() override;
 	//end Combat Interface
 
+	// スポーンディレクター経由で出現した敵をプールに戻す（サーバーのみ。それ以外の敵の死亡処理は変えない）
+	void Die();
+
+	bool IsManagedBySpawnDirector() const { return bManagedBySpawnDirector; }
+
+private:
+	friend class UAuraEnemySpawnDirector;
+	friend class UAuraCrowdMovementSubsystem;
+
+	// ASCの初期化・初期属性（プールの敵は1回だけ行う）
+	void InitializeEnemy();
+
+	void ActivateFromPool(const FTransform& SpawnTransform);
+	void DeactivateToPool();
+
+	// 前の出現中に付いたGE・ルーズタグを外す（初期属性のGEは残す）
+	void ClearCombatState();
+
+	// SignificanceManagerから呼ばれる（計算はワーカースレッドで並列に行われる）
+	float CalculateSignificance(const FTransform& Viewpoint) const;
+	void ApplySignificanceBucket(int32 BucketIndex);
+
+	int32 CurrentSignificanceBucket = INDEX_NONE;
+
+	// クライアントでの補間（0 -> 1で前回の位置からCrowdNetStateへ）
+	FVector CrowdInterpFromLocation = FVector::ZeroVector;
+	FQuat CrowdInterpFromRotation = FQuat::Identity;
+	float CrowdInterpAlpha = 2.f;
+
+	// FinishSpawningの前にディレクターが設定する。trueの場合BeginPlayでは初期化しない
+	bool bManagedBySpawnDirector = false;
+	bool bEnemyInitialized = false;
+	bool bInPool = false;
 
 };
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraEnemySpawnDirector.generated.h"
+
+class AAuraEnemy;
+
+USTRUCT()
+struct FAuraEnemyPool
+{
+	GENERATED_BODY()
+
+	// 非表示・コリジョン無効・休止状態で待機している敵
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraEnemy>> FreeEnemies;
+
+	// 事前生成の残り数
+	int32 NumToPrewarm = 0;
+};
+
+struct FAuraEnemySpawnRequest
+{
+	TSubclassOf<AAuraEnemy> EnemyClass;
+	FTransform Transform;
+};
+
+/**
+ * 敵の出現をフレーム予算内に分散させ、倒された敵をクラスごとのプールに戻して使い回す（サーバーのみ）
+ * 予算は Aura.SpawnDirector.BudgetMs で変更できる
+ */
+UCLASS(Config = Game)
+class AURA_API UAuraEnemySpawnDirector : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 非アクティブな敵を事前に生成しておく（生成自体もフレーム予算内で行う）
+	UFUNCTION(BlueprintCallable, Category = "Aura|SpawnDirector")
+	void PrewarmEnemies(TSubclassOf<AAuraEnemy> EnemyClass, int32 Count);
+
+	// 出現を予約する。次のフレーム以降、予算内で順番にプールから取り出す
+	UFUNCTION(BlueprintCallable, Category = "Aura|SpawnDirector")
+	void QueueSpawn(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform);
+
+	// 倒された敵をプールに戻す。非アクティブ化は次のTickで行う
+	UFUNCTION(BlueprintCallable, Category = "Aura|SpawnDirector")
+	void ReleaseEnemy(AAuraEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Aura|SpawnDirector")
+	int32 GetNumQueuedSpawns() const { return PendingSpawns.Num() - NextSpawnIndex; }
+
+	UFUNCTION(BlueprintPure, Category = "Aura|SpawnDirector")
+	int32 GetNumPooledEnemies(TSubclassOf<AAuraEnemy> EnemyClass) const;
+
+	// クラスごとにプールに保持する敵の上限。超えた分は破棄する
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|SpawnDirector")
+	int32 MaxPooledEnemiesPerClass = 64;
+
+private:
+	AAuraEnemy* SpawnPooledEnemy(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform);
+	void ActivateEnemy(const FAuraEnemySpawnRequest& Request);
+	void DeactivateEnemy(AAuraEnemy* Enemy);
+	bool HasPendingWork() const;
+
+	UPROPERTY()
+	TMap<TSubclassOf<AAuraEnemy>, FAuraEnemyPool> Pools;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraEnemy>> PendingReleases;
+
+	// 先頭から順に処理し、空になったらまとめて詰める
+	TArray<FAuraEnemySpawnRequest> PendingSpawns;
+	int32 NextSpawnIndex = 0;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "AuraFlowFieldSubsystem.generated.h"
+
+class APlayerState;
+
+// ナビメッシュ上のセル（ゲームスレッドでサンプリングしてキャッシュする）
+struct FAuraFlowFieldCell
+{
+	float Height = 0.f;
+	bool bWalkable = false;
+};
+
+// 1人のプレイヤーに向かうフローフィールド（ワーカースレッドで作成し、完成後は読み取り専用）
+struct FAuraFlowField
+{
+	static constexpr uint8 NoDirection = 0xFF;
+	static constexpr uint16 Unreachable = 0xFFFF;
+
+	// 左下のセル座標と1辺のセル数
+	FIntPoint OriginCell = FIntPoint::ZeroValue;
+	int32 Size = 0;
+	float CellSize = 100.f;
+	FIntPoint TargetCell = FIntPoint::ZeroValue;
+
+	// ターゲットまでのセル数と、次に進む隣接セル（8方向のインデックス）
+	TArray<uint16> Distances;
+	TArray<uint8> Directions;
+
+	bool Sample(const FVector& Location, FVector& OutDirection, int32& OutDistance) const;
+};
+
+/**
+ * プレイヤーごとにナビメッシュ上のフローフィールドを作り、敵は位置から進む方向を引くだけにする（サーバーのみ）
+ * 敵の数に関係なく、経路計算のコストはフィールドの大きさで決まる
+ * - ナビデータはクリック移動（FindPathToLocationSynchronously）と同じデフォルトのものを使う
+ * - セルの歩行可否はキャッシュし、プレイヤーが別のセルに移動したら幅優先探索だけをワーカースレッドでやり直す
+ */
+UCLASS(Config = Game)
+class AURA_API UAuraFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Locationを含むフィールドのうち、経路上で最も近いプレイヤーへの方向を返す
+	bool SampleDirection(const FVector& Location, FVector& OutDirection) const;
+
+	// セルの大きさ（cm）
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|FlowField")
+	float CellSize = 100.f;
+
+	// プレイヤーを中心に、この数のセルまで（1辺 2 * HalfExtentCells + 1）
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|FlowField")
+	int32 HalfExtentCells = 40;
+
+	// 隣接セルとの高さの差がこれ以上なら通れない
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|FlowField")
+	float MaxStepHeight = 60.f;
+
+private:
+	using FFieldPtr = TSharedPtr<const FAuraFlowField, ESPMode::ThreadSafe>;
+
+	struct FPlayerField
+	{
+		// 完成したフィールド（敵はこれを参照する）と作成中のタスク
+		FFieldPtr Current;
+		UE::Tasks::TTask<FFieldPtr> PendingTask;
+		bool bTaskInFlight = false;
+		FIntPoint BuiltForCell = FIntPoint(MAX_int32, MAX_int32);
+	};
+
+	void UpdatePlayerField(const FVector& TargetLocation, FPlayerField& Field, int32& SampleBudget);
+	bool SampleWindow(const FIntPoint& OriginCell, int32 Size, float ReferenceHeight, int32& SampleBudget);
+	FIntPoint ToCell(const FVector& Location) const;
+
+	// ナビメッシュが作り直されたらキャッシュを捨てる
+	UFUNCTION()
+	void OnNavigationGenerationFinished(class ANavigationData* NavData);
+
+	TMap<TWeakObjectPtr<const APlayerState>, FPlayerField> PlayerFields;
+	TMap<FIntPoint, FAuraFlowFieldCell> CellCache;
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraSignificanceSubsystem.generated.h"
+
+// 重要度バケットごとの更新頻度（0はフレームごと）
+USTRUCT(BlueprintType)
+struct FAuraSignificanceBucket
+{
+	GENERATED_BODY()
+
+	// 最も近いプレイヤーとの距離がこれ以下ならこのバケット（最後のバケットは距離に関係なく使う）
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MaxDistance = 1500.f;
+
+	// メッシュ（アニメーション）のTick間隔
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MeshTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	float MovementTickInterval = 0.f;
+
+	// falseの場合は武器メッシュのポーズ更新を止める
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bUpdateWeaponPose = true;
+};
+
+/**
+ * 敵を最も近いプレイヤーとの距離・描画されているかでバケット分けするためにSignificanceManagerを一定間隔で更新する
+ * バケットごとの設定は AAuraEnemy::SignificanceBuckets
+ */
+UCLASS()
+class AURA_API UAuraSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static const FName EnemyTag;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	float TimeSinceUpdate = 0.f;
+
+	// 毎回確保しないよう使い回す
+	TArray<FTransform> Viewpoints;
+};
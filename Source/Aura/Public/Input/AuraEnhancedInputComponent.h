@@ -7,6 +7,10 @@
 #include "EnhancedInputComponent.h"
 #include "AuraEnhancedInputComponent.generated.h"
 
+// スロットごとのハンドラ表（EAuraInputSlotでインデックス）
+template<typename FuncType>
+using TAuraInputSlotHandlers = TStaticArray<FuncType, AuraInputSlotCount>;
+
 /**
  * 
  */
@@ -17,33 +21,37 @@ class AURA_API UAuraEnhancedInputComponent : public UEnhancedInputComponent
 	
 public:
 	template<class UserClass, typename PressedFuncType, typename ReleasedFuncType, typename HeldFuncType >
-	void BindAbilityActions(const UAuraInputConfig* InputConfig, UserClass* Object, PressedFuncType PressedFunc, ReleasedFuncType ReleasedFunc, HeldFuncType HeldFunc );
+	void BindAbilityActions(const UAuraInputConfig* InputConfig, UserClass* Object, const TAuraInputSlotHandlers<PressedFuncType>& PressedFuncs, const TAuraInputSlotHandlers<ReleasedFuncType>& ReleasedFuncs, const TAuraInputSlotHandlers<HeldFuncType>& HeldFuncs);
 };
 
 template <class UserClass, typename PressedFuncType, typename ReleasedFuncType, typename HeldFuncType>
 void UAuraEnhancedInputComponent::BindAbilityActions(const UAuraInputConfig* InputConfig, UserClass* Object,
-	PressedFuncType PressedFunc, ReleasedFuncType ReleasedFunc, HeldFuncType HeldFunc)
+	const TAuraInputSlotHandlers<PressedFuncType>& PressedFuncs, const TAuraInputSlotHandlers<ReleasedFuncType>& ReleasedFuncs, const TAuraInputSlotHandlers<HeldFuncType>& HeldFuncs)
 {
 	check(InputConfig);
 
-	for (const FAuraInputAction& Action : InputConfig->AbilityInputActions)
+	// InputTagの解決はここで一度だけ行い、コールバックにはスロット番号を渡す
+	const TStaticArray<const UInputAction*, AuraInputSlotCount>& SlotInputActions = InputConfig->GetSlotInputActions();
+	for (int32 Index = 0; Index < AuraInputSlotCount; ++Index)
 	{
-		if (Action.InputAction && Action.InputTag.IsValid())
+		const UInputAction* InputAction = SlotInputActions[Index];
+		if (!InputAction) continue;
+
+		const EAuraInputSlot Slot = static_cast<EAuraInputSlot>(Index);
+
+		if (PressedFuncs[Index])
+		{
+			BindAction(InputAction, ETriggerEvent::Started, Object, PressedFuncs[Index], Slot);
+		}
+
+		if (ReleasedFuncs[Index])
 		{
-			if (PressedFunc)
-			{
-				BindAction(Action.InputAction, ETriggerEvent::Started, Object, PressedFunc, Action.InputTag);
-			}
-
-			if (ReleasedFunc)
-			{
-				BindAction(Action.InputAction, ETriggerEvent::Completed, Object, ReleasedFunc, Action.InputTag);
-			}
+			BindAction(InputAction, ETriggerEvent::Completed, Object, ReleasedFuncs[Index], Slot);
+		}
 			
-			if (HeldFunc)
-			{
-				BindAction(Action.InputAction, ETriggerEvent::Triggered, Object, HeldFunc, Action.InputTag);;
-			}
+		if (HeldFuncs[Index])
+		{
+			BindAction(InputAction, ETriggerEvent::Triggered, Object, HeldFuncs[Index], Slot);
 		}
 	}
 }
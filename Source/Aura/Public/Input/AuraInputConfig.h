@@ -7,6 +7,21 @@
 #include "Engine/DataAsset.h"
 #include "AuraInputConfig.generated.h"
 
+// 入力スロット：InputTagをバインド時に固定インデックスへ変換する
+UENUM(BlueprintType)
+enum class EAuraInputSlot : uint8
+{
+	LMB,
+	RMB,
+	Key1,
+	Key2,
+	Key3,
+	Key4,
+	MAX UMETA(Hidden)
+};
+
+constexpr int32 AuraInputSlotCount = static_cast<int32>(EAuraInputSlot::MAX);
+
 USTRUCT(BlueprintType)
 struct FAuraInputAction
 {
@@ -31,7 +46,24 @@ class AURA_API UAuraInputConfig : public UDataAsset
 public:
 
 	const UInputAction* FindAbilityInputActionForTag(const FGameplayTag InputTag, bool bLogNotFound = false) const;
+	const UInputAction* FindAbilityInputActionForSlot(EAuraInputSlot Slot) const;
+
+	static EAuraInputSlot GetSlotForInputTag(const FGameplayTag& InputTag);
+	static const FGameplayTag& GetInputTagForSlot(EAuraInputSlot Slot);
+	
+	// スロット順に並べたInputAction（初回呼び出し＝入力バインド時に作成）
+	const TStaticArray<const UInputAction*, AuraInputSlotCount>& GetSlotInputActions() const;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TArray<FAuraInputAction> AbilityInputActions;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	void CompileInputSlots() const;
+
+	mutable TStaticArray<const UInputAction*, AuraInputSlotCount> SlotInputActions{InPlace, nullptr};
+	mutable bool bInputSlotsCompiled = false;
 };
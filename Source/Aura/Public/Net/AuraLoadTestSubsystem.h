@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraLoadTestSubsystem.generated.h"
+
+/**
+ * レプリケーション負荷テスト用の記録（-AuraLoadTest を付けたサーバーでのみ作られる）
+ * 1秒ごとに接続ごとの送受信バイト数・パケットロス・遅延とサーバーのゲームスレッド時間（待機を除く）を
+ * Saved/Profiling/AuraLoadTest/ のCSVに追記する。-AuraLoadTestDuration=秒 で時間が来たら終了する
+ * クラス・プロパティ別の内訳は -csvCaptureFrames（ReplicationGraphのCSVTracker）と -NetTrace で取る
+ */
+UCLASS()
+class AURA_API UAuraLoadTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void WriteSample();
+
+	FString CsvFilename;
+	float Duration = 0.f;
+	float ElapsedTime = 0.f;
+	float TimeSinceSample = 0.f;
+
+	// 前回のサンプルからのゲームスレッド時間
+	int32 NumFrames = 0;
+	float TotalGameThreadTime = 0.f;
+	float MaxGameThreadTime = 0.f;
+};
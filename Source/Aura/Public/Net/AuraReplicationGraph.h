@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "Net/AuraReplicationGraphSettings.h"
+#include "AuraReplicationGraph.generated.h"
+
+/**
+ * Aura用のReplicationGraph（DefaultEngine.ini の ReplicationDriverClassName で有効化）
+ * - 敵・投射物: 空間グリッド（接続の視点からカリング距離内のセルだけを見る）
+ * - PlayerState・GameState: 全接続に常に送るノード
+ * - ピックアップ（AAuraEffectActor）: 休止前提の専用グリッド
+ * クラスごとのノード・更新頻度・カリング距離は UAuraReplicationGraphSettings で変更できる
+ */
+UCLASS(Transient, Config = Engine)
+class AURA_API UAuraReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	// グラフはアクター登録時の頻度（CDOと違えばインスタンスの値）を保持するので、実行中にNetUpdateFrequencyを変えたらこれで反映する
+	void SetActorNetUpdateFrequency(AActor* Actor, float NetUpdateFrequency);
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> PickupGridNode;
+
+private:
+	EAuraClassRepNodeMapping GetMappingPolicy(const UClass* Class);
+
+	TClassMap<EAuraClassRepNodeMapping> ClassRepNodePolicies;
+};
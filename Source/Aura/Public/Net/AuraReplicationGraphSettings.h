@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AuraReplicationGraphSettings.generated.h"
+
+// アクタークラスをどのノードに入れるか
+UENUM()
+enum class EAuraClassRepNodeMapping : uint8
+{
+	NotRouted,				// ノードに入れない（PlayerControllerのように接続ごとに扱うもの）
+	RelevantAllConnections,	// 常に全接続に送る（PlayerState・GameState）
+	Spatialize_Static,		// グリッド: 動かない
+	Spatialize_Dynamic,		// グリッド: 毎フレーム位置を更新（敵・投射物）
+	Spatialize_Dormancy,	// グリッド: 休止中は静的、起きている間は動的
+	Pickup,					// ピックアップ用のグリッド（休止前提）
+};
+
+USTRUCT()
+struct FAuraRepGraphClassSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	TSoftClassPtr<AActor> ActorClass;
+
+	UPROPERTY(EditAnywhere)
+	EAuraClassRepNodeMapping NodeMapping = EAuraClassRepNodeMapping::Spatialize_Dynamic;
+
+	// 0の場合はクラスのNetUpdateFrequencyを使う
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
+	float NetUpdateFrequency = 0.f;
+
+	// 0の場合はクラスのNetCullDistanceSquaredを使う
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
+	float CullDistance = 0.f;
+};
+
+/**
+ * UAuraReplicationGraphの設定（プロジェクト設定 > Game > Aura Replication Graph）
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Aura Replication Graph"))
+class AURA_API UAuraReplicationGraphSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// 敵・投射物のグリッドのセルの大きさ
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial Grid")
+	float SpatialCellSize = 10000.f;
+
+	// グリッドの原点（マップの左下がこれより大きければセルの再確保が起きない）
+	UPROPERTY(Config, EditAnywhere, Category = "Spatial Grid")
+	FVector2D SpatialBias = FVector2D(-200000.f, -200000.f);
+
+	// ピックアップ用のグリッドのセルの大きさ
+	UPROPERTY(Config, EditAnywhere, Category = "Pickups")
+	float PickupCellSize = 20000.f;
+
+	// 既定の割り当て（AAuraEnemy・AAuraProjectileは動的、AAuraEffectActorはピックアップ）を上書きする
+	UPROPERTY(Config, EditAnywhere, Category = "Classes")
+	TArray<FAuraRepGraphClassSettings> ClassSettings;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CheatManager.h"
+#include "AuraCheatManager.generated.h"
+
+/**
+ * 計測用のチートコマンド（サーバー側：スタンドアロン・リッスンサーバーで実行）
+ */
+UCLASS()
+class AURA_API UAuraCheatManager : public UCheatManager
+{
+	GENERATED_BODY()
+
+public:
+	// 例: SpawnEnemies /Game/Blueprints/Characters/Goblin_Spear/BP_Goblin_Spear.BP_Goblin_Spear_C 300
+	UFUNCTION(Exec)
+	void SpawnEnemies(const FString& EnemyClassPath, int32 Count = 300);
+
+	// スポーンディレクター経由で出現させる（フレーム予算内に分散）。Prewarmを指定すると先にプールを作る
+	UFUNCTION(Exec)
+	void SpawnEnemyWave(const FString& EnemyClassPath, int32 Count = 100, int32 Prewarm = 0);
+
+	// 出現中の敵をすべて倒す（ディレクター管理の敵はプールに戻る）
+	UFUNCTION(Exec)
+	void KillAllEnemies();
+
+	// AbilitySetの共有テンプレートからの付与と、クラスから毎回Specを作る付与を比較する
+	UFUNCTION(Exec)
+	void BenchAbilityGrants(const FString& AbilitySetPath, int32 Count = 300);
+
+	// 空間ハッシュの半径検索と OverlapMultiByChannel を比較する（球コリジョンのアクターを一時的に配置する）
+	UFUNCTION(Exec)
+	void BenchSpatialQueries(int32 NumActors = 1000, int32 NumQueries = 1000, float Radius = 500.f);
+
+	// FGameplayTagContainer::HasTag / HasAny とネイティブタグのビットセットを比較する
+	UFUNCTION(Exec)
+	void BenchNativeTagQueries(int32 Iterations = 100000);
+
+	// オーバーレイのメッセージ行検索（GEごとにアセットタグ10個）を、従来のFindRowとタグ→行マップで比較する
+	// 例: BenchOverlayMessageTags /Game/Blueprints/UI/Data/DT_MessageWidgetData.DT_MessageWidgetData
+	UFUNCTION(Exec)
+	void BenchOverlayMessageTags(const FString& DataTablePath, int32 Iterations = 10000);
+};
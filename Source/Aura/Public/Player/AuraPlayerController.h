@@ -6,6 +6,7 @@
 #include "GameFramework/PlayerController.h"
 #include "GameplayTagContainer.h"
 #include "InputMappingContext.h"
+#include "Input/AuraInputConfig.h"
 #include "AuraPlayerController.generated.h" 
 
 class USplineComponent;
@@ -29,6 +30,9 @@ public:
 	AAuraPlayerController();
 	virtual void PlayerTick(float DeltaTime) override;
 
+	// ロードテスト用ボット（-AuraBot）が狙っている地点。ボットでなければfalse（UTargetDataUnderMouseがカーソルの代わりに使う）
+	bool GetBotTargetHit(FHitResult& OutHit) const;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void SetupInputComponent() override;
@@ -50,10 +54,17 @@ private:
 	TScriptInterface<IEnemyInterface> ThisActor;
 	FHitResult CursorHit;
 
-	// Call Back関数
-	void AbilityInputTagPressed(FGameplayTag InputTag);
-	void AbilityInputTagReleased(FGameplayTag InputTag);
-	void AbilityInputTagHeld(FGameplayTag InputTag);
+	// Call Back関数（LMBはバインド時に専用ハンドラへ振り分ける）
+	void AbilityInputPressed(EAuraInputSlot Slot);
+	void AbilityInputReleased(EAuraInputSlot Slot);
+	void AbilityInputHeld(EAuraInputSlot Slot);
+
+	void LMBInputPressed(EAuraInputSlot Slot);
+	void LMBInputReleased(EAuraInputSlot Slot);
+	void LMBInputHeld(EAuraInputSlot Slot);
+
+	// スロット→InputTag（SetupInputComponentで作成）
+	TStaticArray<FGameplayTag, AuraInputSlotCount> SlotInputTags;
 
 	void ShiftPressed(){bShiftKeyDown = true;};
 	void ShiftReleased(){bShiftKeyDown = false;};
@@ -81,4 +92,28 @@ private:
 	bool bShiftKeyDown = false;
 
 	void AutoRun();
+
+	// Destinationまでのナビパスをスプラインにして自動移動を始める
+	void MoveToLocation(const FVector& Destination);
+
+	/* ロードテスト用ボット（-AuraBot で起動したクライアントのローカルコントローラー） */
+	void TickBot(float DeltaTime);
+	void BotMoveRandomly();
+	void BotCastProjectile();
+	void BotMoveToPickup();
+
+	UPROPERTY(EditDefaultsOnly, Category = "Bot")
+	float BotActionInterval = 1.5f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Bot")
+	float BotMoveRadius = 1500.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Bot")
+	float BotSearchRadius = 3000.f;
+
+	bool bBotEnabled = false;
+	float BotTimeToNextAction = 0.f;
+	bool bHasBotTarget = false;
+	FVector BotTargetLocation = FVector::ZeroVector;
+	TWeakObjectPtr<AActor> BotTargetActor;
 };
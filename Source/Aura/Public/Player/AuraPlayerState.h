@@ -9,9 +9,19 @@
 
 class UAbilitySystemComponent;
 class UAttributeSet;
+struct FActiveGameplayEffect;
+struct FActiveGameplayEffectHandle;
+struct FAbilityEndedData;
+struct FGameplayAbilitySpec;
+struct FGameplayEffectSpec;
+struct FGameplayTag;
+class UGameplayAbility;
+struct FOnAttributeChangeData;
 
 /**
- * 
+ * ASCとAttributeSetを持つプレイヤーのPlayerState
+ * サーバーでは属性・GE・Ability・タグ・レベルが変化している間だけCombatNetUpdateFrequencyで複製し、
+ * CombatCooldown秒変化がなければIdleNetUpdateFrequencyに落とす
  */
 UCLASS()
 class AURA_API AAuraPlayerState : public APlayerState, public IAbilitySystemInterface
@@ -21,10 +31,12 @@ class AURA_API AAuraPlayerState : public APlayerState, public IAbilitySystemInte
 public:
 	AAuraPlayerState();
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;;
+	virtual void BeginPlay() override;
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 	UAttributeSet* GetAttributeSet() const { return AttributeSet; }
 
 	FORCEINLINE int32 GetPlayerLevel() const { return Level; }
+	void SetPlayerLevel(int32 InLevel);
 	
 protected:
 	UPROPERTY(VisibleAnywhere)
@@ -33,10 +45,37 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UAttributeSet> AttributeSet;
 
+	UPROPERTY(EditDefaultsOnly, Category = "Net", meta = (ClampMin = "1"))
+	float CombatNetUpdateFrequency = 100.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Net", meta = (ClampMin = "0.1"))
+	float IdleNetUpdateFrequency = 2.f;
+
+	// 最後の変化からこの秒数でアイドルに戻す
+	UPROPERTY(EditDefaultsOnly, Category = "Net", meta = (ClampMin = "0"))
+	float CombatCooldown = 3.f;
+
 private:
 	UPROPERTY(VisibleAnywhere, ReplicatedUsing = OnRep_Level)
 	int32 Level = 1;
 
 	UFUNCTION()
 	void OnRep_Level(int32 OldLevel);
+
+	void OnAttributeChanged(const FOnAttributeChangeData& Data);
+	void OnGameplayEffectApplied(UAbilitySystemComponent* Target, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+	void OnGameplayEffectRemoved(const FActiveGameplayEffect& Effect);
+	void OnAbilityGiven(const FGameplayAbilitySpec& AbilitySpec);
+	void OnAbilityActivated(UGameplayAbility* Ability);
+	void OnAbilityEnded(const FAbilityEndedData& EndedData);
+	void OnGameplayTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	// 複製する状態が変化したときに呼ぶ（アイドル中なら戦闘中の頻度に上げる）
+	void NotifyCombatActivity();
+	void CheckCombatCooldown();
+	void SetReplicationFrequency(float Frequency);
+
+	bool bInCombat = false;
+	double LastCombatActivityTime = 0.0;
+	FTimerHandle CombatCooldownTimer;
 };
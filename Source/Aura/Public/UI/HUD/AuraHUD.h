@@ -27,14 +27,19 @@ public:
 	UOverlayWidgetController* GetOverlayWidgetController(const FWidgetControllerParams& WCParams);
 	UAuraMenuWidgetController* GetAttributeMenuWidgetController(const FWidgetControllerParams& WCParams);
 	
+	// OverlayWidgetClassとコントローラーのアセットを非同期で読み込み、完了したら表示する
 	void InitOverlay(APlayerController* PC, APlayerState* PS, UAbilitySystemComponent* ASC, UAttributeSet* AS);
 
 private:
+	void ShowOverlay();
+
+	double OverlayRequestTime = 0.0;
+
 	UPROPERTY()
 	TObjectPtr<UAuraUserWidget> OverlayWidget;
 	
 	UPROPERTY(EditAnywhere)
-	TSubclassOf<UAuraUserWidget> OverlayWidgetClass;
+	TSoftClassPtr<UAuraUserWidget> OverlayWidgetClass;
 
 	UPROPERTY()
 	TObjectPtr<UOverlayWidgetController> OverlayWidgetController;
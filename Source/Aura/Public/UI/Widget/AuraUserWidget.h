@@ -6,6 +6,9 @@
 #include "Blueprint/UserWidget.h"
 #include "AuraUserWidget.generated.h"
 
+class UAuraWidgetPoolSubsystem;
+class UAuraMenuWidgetController;
+
 /**
  * 
  */
@@ -22,7 +25,31 @@ public:
 	TObjectPtr<UObject> WidgetController;
 
 protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+
 	UFUNCTION(BlueprintImplementableEvent)
 	void WidgetControllerSet();
-	
+
+	// プールから取り出された時に呼ばれる（表示内容のリセットやアニメーションの再生用）
+	UFUNCTION(BlueprintImplementableEvent)
+	void WidgetAcquiredFromPool();
+
+	virtual void OnAnimationFinished_Implementation(const UWidgetAnimation* Animation) override;
+
+	// プールから取得した場合、全てのアニメーションが終わったらプールに戻す
+	UPROPERTY(EditDefaultsOnly, Category = "WidgetPool")
+	bool bReleaseToPoolOnAnimationFinished = true;
+
+private:
+	friend class UAuraWidgetPoolSubsystem;
+
+	TWeakObjectPtr<UAuraWidgetPoolSubsystem> OwningPool;
+	bool bInPool = false;
+
+	// 属性メニューのコントローラーに表示中であることを伝える（表示中の間だけ購読させる）
+	void UpdateMenuControllerOpen();
+
+	bool bConstructed = false;
+	TWeakObjectPtr<UAuraMenuWidgetController> OpenedMenuController;
 };
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "AuraWidgetPoolSubsystem.generated.h"
+
+class UAuraUserWidget;
+
+USTRUCT()
+struct FAuraWidgetPool
+{
+	GENERATED_BODY()
+
+	// 使用中（古い順）
+	UPROPERTY()
+	TArray<TObjectPtr<UAuraUserWidget>> ActiveWidgets;
+
+	// 再利用待ち
+	UPROPERTY()
+	TArray<TObjectPtr<UAuraUserWidget>> FreeWidgets;
+};
+
+/**
+ * メッセージやダメージ表示など、短命なUAuraUserWidgetを使い回すためのプール
+ */
+UCLASS(Config = Game)
+class AURA_API UAuraWidgetPoolSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// 事前にウィジェットを作成しておく
+	UFUNCTION(BlueprintCallable, Category = "Aura|WidgetPool")
+	void PrewarmWidgets(TSubclassOf<UAuraUserWidget> WidgetClass, int32 Count);
+
+	// プールから取り出す。ビューポートや親への追加は呼び出し側で行う
+	UFUNCTION(BlueprintCallable, Category = "Aura|WidgetPool", meta = (DeterminesOutputType = "WidgetClass"))
+	UAuraUserWidget* AcquireWidget(TSubclassOf<UAuraUserWidget> WidgetClass);
+
+	UFUNCTION(BlueprintCallable, Category = "Aura|WidgetPool")
+	void ReleaseWidget(UAuraUserWidget* Widget);
+
+	UFUNCTION(BlueprintPure, Category = "Aura|WidgetPool")
+	int32 GetWidgetCreationsAvoided() const { return WidgetCreationsAvoided; }
+
+	UFUNCTION(BlueprintPure, Category = "Aura|WidgetPool")
+	int32 GetWidgetsDropped() const { return WidgetsDropped; }
+
+	// クラスごとの使用中ウィジェットの上限。超えた場合は一番古いものを回収する
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|WidgetPool")
+	int32 MaxActiveWidgetsPerClass = 32;
+
+	// クラスごとに保持しておく再利用待ちウィジェットの上限
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Aura|WidgetPool")
+	int32 MaxFreeWidgetsPerClass = 32;
+
+private:
+	UAuraUserWidget* CreatePooledWidget(TSubclassOf<UAuraUserWidget> WidgetClass);
+
+	UPROPERTY()
+	TMap<TSubclassOf<UAuraUserWidget>, FAuraWidgetPool> Pools;
+
+	int32 WidgetCreationsAvoided = 0;
+	int32 WidgetsDropped = 0;
+};
@@ -3,14 +3,29 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "AbilitySystem/Data/AttributeInfo.h"
 #include "UI/WidgetController/AuraWidgetController.h"
 #include "AuraMenuWidgetController.generated.h"
 
 struct FGameplayAttribute;
-struct FGameplayTag;
-class UAttributeInfo;
-struct  FAuraAttributeInfo;
+
+// 属性変化の通知。名前や説明はGetAttributeInfoで一度だけ取得する
+USTRUCT(BlueprintType)
+struct FAuraAttributeValue
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FGameplayTag AttributeTag = FGameplayTag();
+
+	UPROPERTY(BlueprintReadOnly)
+	float AttributeValue = 0.f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAttributeValueSignature, const FAuraAttributeValue&, Value);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAttributeInfoSignature, const FAuraAttributeInfo&, Info);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FMenuAssetsLoadedSignature);
 
 
 /**
@@ -24,15 +39,49 @@ class AURA_API UAuraMenuWidgetController : public UAuraWidgetController
 public:
 	virtual void BindCallbacksToDependencies() override;
 	virtual void BroadcastInitialValues() override;
+	virtual void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const override;
+
+	// メニューを開いている間だけ属性の変化を購読する（UAuraUserWidgetのNativeConstruct/NativeDestructから呼ばれる）
+	UFUNCTION(BlueprintCallable, Category="GAS|Attributes")
+	void MenuOpened();
+
+	UFUNCTION(BlueprintCallable, Category="GAS|Attributes")
+	void MenuClosed();
 
+	UPROPERTY(BlueprintAssignable, Category="GAS|Attributes")
+	FAttributeValueSignature AttributeValueDelegate;
+
+	// 既存の属性メニューBlueprint用。購読者がいる時だけ、読み込み時にキャッシュした情報に値を入れて通知する
 	UPROPERTY(BlueprintAssignable, Category="GAS|Attributes")
 	FAttributeInfoSignature AttributeInfoDelegate;
 
+	// 初回オープン時のAttributeInfo読み込み完了（スナップショット通知の直前）。ここでGetAttributeInfoを使う
+	UPROPERTY(BlueprintAssignable, Category="GAS|Attributes")
+	FMenuAssetsLoadedSignature MenuAssetsLoadedDelegate;
+
+	// ウィジェット構築時に静的なテキストを取得する
+	UFUNCTION(BlueprintPure, Category="GAS|Attributes")
+	const FAuraAttributeInfo& GetAttributeInfo(const FGameplayTag& AttributeTag) const;
+
+
+	// 読み込み済みのAttributeInfo（読み込み前なら同期読み込みになる）
+	UFUNCTION(BlueprintPure, Category="GAS|Attributes")
+	UAttributeInfo* GetAttributeInfoAsset() const { return AttributeInfo.LoadSynchronous(); }
 
 protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-	TObjectPtr<UAttributeInfo> AttributeInfo;
+	TSoftObjectPtr<UAttributeInfo> AttributeInfo;
 
 private:
-	void BroadcastAttributeInfo(const FGameplayTag& AttributeTag, const FGameplayAttribute& Attribute) const;
+	void SubscribeAndSnapshot();
+	void BindAttributeCallbacks();
+
+	// このコントローラーを使っている表示中のウィジェットの数
+	int32 OpenCount = 0;
+
+	void BroadcastAttributeValue(const FGameplayTag& AttributeTag, const FGameplayAttribute& Attribute);
+
+	// AttributeInfoDelegate用に、AttributeInfoの各行を読み込み時に1回だけコピーしておく
+	void CacheLegacyAttributeInfos();
+	TMap<FGameplayTag, FAuraAttributeInfo> LegacyAttributeInfos;
 };
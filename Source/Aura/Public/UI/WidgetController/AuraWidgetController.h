@@ -4,11 +4,26 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "AttributeSet.h"
 #include "AuraWidgetController.generated.h"
 
+struct FStreamableHandle;
+
 class UAbilitySystemComponent;
 class UAttributeSet;
 class UAuraAttributeSet;
+struct FOnAttributeChangeData;
+
+// 属性1つ分の通知先と、フレーム内の最新値
+struct FAuraAttributeBroadcastSlot
+{
+	FGameplayAttribute Attribute;
+	TFunction<void(float)> Broadcast;
+	FDelegateHandle DelegateHandle;
+	float PendingValue = 0.f;
+	float LastBroadcastValue = 0.f;
+	bool bHasBroadcast = false;
+};
 
 USTRUCT(BlueprintType)
 struct FWidgetControllerParams
@@ -52,8 +67,17 @@ public:
 	UFUNCTION(BlueprintCallable)
 	virtual void BroadcastInitialValues();
 	virtual void BindCallbacksToDependencies();
+
+	// ウィジェットが使うソフト参照のアセット
+	virtual void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const {}
+
+	// GetAssetsToLoad + ExtraAssets をバックグラウンドで読み込み、完了したらOnLoadedを呼ぶ
+	void LoadAssets(FSimpleDelegate OnLoaded, const TArray<FSoftObjectPath>& ExtraAssets = TArray<FSoftObjectPath>());
+	bool AreAssetsLoaded() const { return bAssetsLoaded; }
 	
 protected:
+	virtual void OnAssetsLoaded() {}
+
 	UPROPERTY(BlueprintReadOnly, Category = "WidgetController")
 	TObjectPtr<APlayerController> PlayerController;
 
@@ -65,4 +89,29 @@ protected:
 
 	UPROPERTY(BlueprintReadOnly, Category = "WidgetController")
 	TObjectPtr<UAttributeSet> AttributeSet;
+
+	// 属性の変化を溜めておき、まとめて（値が変わった時だけ）通知する
+	void BindAttributeChange(const FGameplayAttribute& Attribute, TFunction<void(float)>&& BroadcastFunc);
+	void UnbindAttributeChanges();
+	void FlushAttributeChanges();
+	bool HasAttributeBindings() const { return AttributeSlots.Num() > 0; }
+
+	// 属性変化の通知間隔（秒）。0の場合は毎フレーム1回
+	UPROPERTY(EditDefaultsOnly, Category = "WidgetController")
+	float AttributeBroadcastInterval = 0.f;
+
+private:
+	void OnAttributeChanged(const FOnAttributeChangeData& Data, int32 SlotIndex);
+	void ScheduleAttributeFlush();
+
+	TArray<FAuraAttributeBroadcastSlot> AttributeSlots;
+	TBitArray<> DirtyAttributeSlots;
+	FTimerHandle AttributeFlushTimer;
+	bool bAttributeFlushScheduled = false;
+	// UnbindAttributeChangesのたびに増やす（フラッシュ中の解除を検出する）
+	uint32 AttributeSlotsGeneration = 0;
+
+	// 読み込んだアセットを保持するためのハンドル
+	TSharedPtr<FStreamableHandle> AssetLoadHandle;
+	bool bAssetsLoaded = false;
 };
@@ -41,6 +41,7 @@ class AURA_API UOverlayWidgetController : public UAuraWidgetController
 public:
 	virtual void BroadcastInitialValues() override;
 	virtual void BindCallbacksToDependencies() override;
+	virtual void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const override;
 
 	UPROPERTY(BlueprintAssignable, Category = "GAS Attributes")
 	FOnAttributeChangedSinature OnHealthChanged;
@@ -56,12 +57,31 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category = "GAS Attributes")
 	FMessageWidgetRowSignature MessageWidgetRowDelegate;
+
+	// 読み込み済みのMessageWidgetDataTable（読み込み前なら同期読み込みになる）
+	UFUNCTION(BlueprintPure, Category = "Widget Data")
+	UDataTable* GetMessageWidgetDataTable() const { return MessageWidgetDataTable.LoadSynchronous(); }
+
+	// 行名 = タグ名のDataTableから Tag → Row のマップを作る（FUIWidgetRowでなければfalse）
+	static bool BuildMessageWidgetRowMap(const UDataTable* DataTable, TMap<FGameplayTag, const FUIWidgetRow*>& OutRows);
 protected:
+	virtual void OnAssetsLoaded() override;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Widget Data")
-	TObjectPtr<UDataTable> MessageWidgetDataTable;
+	TSoftObjectPtr<UDataTable> MessageWidgetDataTable;
 
 	template<typename  T>
 	T* GetDataTableRowByTag(UDataTable* DataTable, const FGameplayTag Tag);
+
+private:
+	// MessageWidgetDataTableをバインド時に Tag → Row のマップへ変換する
+	void BuildMessageWidgetRows();
+	void BroadcastMessageTag(const FGameplayTag& Tag) const;
+
+	TMap<FGameplayTag, const FUIWidgetRow*> MessageWidgetRows;
+
+	// DataTableの読み込み完了前に届いたメッセージ（OnAssetsLoadedで通知する）
+	TArray<FGameplayTag> PendingMessageTags;
 	
 };
 
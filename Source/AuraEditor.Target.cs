@@ -10,6 +10,10 @@ public class AuraEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V4;
 
-		ExtraModuleNames.AddRange( new string[] { "Aura" } );
+		// Push model replication (UAuraAttributeSet, AAuraPlayerState) is compiled in by the engine's
+		// default for Server and Editor targets and enabled at runtime by net.IsPushModelEnabled.
+		// Forcing bWithPushModel needs a unique build environment, i.e. a source-built engine.
+
+		ExtraModuleNames.AddRange( new string[] { "Aura", "AuraEditor" } );
 	}
 }
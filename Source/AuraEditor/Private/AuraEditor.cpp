@@ -0,0 +1,6 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Modules/ModuleManager.h"
+
+// ベイク用コマンドレットなど、ゲーム・サーバーのバイナリに含めないエディター専用のコード
+IMPLEMENT_MODULE(FDefaultModuleImpl, AuraEditor);
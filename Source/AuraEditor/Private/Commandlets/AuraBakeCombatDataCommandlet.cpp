@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/AuraBakeCombatDataCommandlet.h"
+#include "AuraAssetManager.h"
+#include "GameplayEffect.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "AbilitySystem/Data/AuraCharacterClassInfo.h"
+#include "AbilitySystem/Data/AuraCombatData.h"
+#include "Misc/FileHelper.h"
+
+namespace AuraBakeCombatData
+{
+	uint64 AppendAligned(TArray64<uint8>& Blob, const void* Items, int64 NumBytes)
+	{
+		Blob.SetNumZeroed(Align(Blob.Num(), 8));
+		const uint64 Offset = Blob.Num();
+		Blob.Append(static_cast<const uint8*>(Items), NumBytes);
+		return Offset;
+	}
+}
+
+UAuraBakeCombatDataCommandlet::UAuraBakeCombatDataCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAuraBakeCombatDataCommandlet::Main(const FString& Params)
+{
+	using namespace AuraBakeCombatData;
+
+	FString EffectPaths = TEXT("/Game/Blueprints/AbilitySystem/GameplayEffects/DefaultAttributes/GE_AuraPrimaryAttributes.GE_AuraPrimaryAttributes_C");
+	FString OutputPath = FAuraCombatData::GetDefaultFilename();
+	int32 MaxLevel = 40;
+
+	FParse::Value(*Params, TEXT("Effects="), EffectPaths);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("MaxLevel="), MaxLevel);
+
+	FAuraCombatDataHeader Header;
+
+	// 初期値GE: 指定されたもの + 全CharacterClassInfoのPrimary/Secondary
+	TArray<UClass*> EffectClasses;
+	TArray<FString> EffectPathList;
+	EffectPaths.ParseIntoArray(EffectPathList, TEXT("+"));
+	for (const FString& EffectPath : EffectPathList)
+	{
+		if (UClass* EffectClass = LoadClass<UGameplayEffect>(nullptr, *EffectPath))
+		{
+			EffectClasses.AddUnique(EffectClass);
+		}
+	}
+
+	TArray<FPrimaryAssetId> ClassInfoIds;
+	UAuraAssetManager::Get().GetPrimaryAssetIdList(UAuraAssetManager::CharacterClassType, ClassInfoIds);
+	for (const FPrimaryAssetId& ClassInfoId : ClassInfoIds)
+	{
+		const FSoftObjectPath ClassInfoPath = UAuraAssetManager::Get().GetPrimaryAssetPath(ClassInfoId);
+		if (const UAuraCharacterClassInfo* ClassInfo = Cast<UAuraCharacterClassInfo>(ClassInfoPath.TryLoad()))
+		{
+			for (const TSoftClassPtr<UGameplayEffect>& Effect : { ClassInfo->PrimaryAttributes, ClassInfo->SecondaryAttributes })
+			{
+				if (UClass* EffectClass = Effect.LoadSynchronous())
+				{
+					EffectClasses.AddUnique(EffectClass);
+				}
+			}
+		}
+	}
+
+	TMap<FGameplayAttribute, EAuraNativeTag> AttributeToNativeTag;
+	for (const TPair<FGameplayTag, TStaticFuncPtr<FGameplayAttribute()>>& Pair : GetDefault<UAuraAttributeSet>()->TagsToAttributes)
+	{
+		if (const EAuraNativeTag* NativeTag = FAuraGameplayTags::Get().FindNativeTag(Pair.Key))
+		{
+			AttributeToNativeTag.Add(Pair.Value(), *NativeTag);
+		}
+	}
+
+	// GEの適用を丸ごと置き換えるので、全Modifierが静的なOverrideのInstant GEだけをベイクする（MMCやAttributeBasedは実行時に計算）
+	TArray<FAuraBakedAttributeDefaults> AttributeDefaults;
+	for (const UClass* EffectClass : EffectClasses)
+	{
+		const UGameplayEffect* Effect = EffectClass->GetDefaultObject<UGameplayEffect>();
+		const uint64 EffectHash = FAuraCombatData::HashName(EffectClass->GetPathName());
+
+		for (int32 Level = 1; Level <= MaxLevel; ++Level)
+		{
+			FAuraBakedAttributeDefaults Row;
+			Row.EffectHash = EffectHash;
+			Row.Level = Level;
+
+			bool bBakeable = FAuraCombatData::HashEffectSource(Effect, Level, Row.SourceHash);
+			for (const FGameplayModifierInfo& Modifier : Effect->Modifiers)
+			{
+				const EAuraNativeTag* NativeTag = AttributeToNativeTag.Find(Modifier.Attribute);
+				float Value = 0.f;
+				if (!bBakeable || !NativeTag || !Modifier.ModifierMagnitude.GetStaticMagnitudeIfPossible(Level, Value))
+				{
+					bBakeable = false;
+					break;
+				}
+				Row.Values[static_cast<uint8>(*NativeTag)] = Value;
+				Row.ValidMask |= AuraNativeTagBit(*NativeTag);
+			}
+
+			if (!bBakeable)
+			{
+				UE_LOG(LogTemp, Display, TEXT("AuraBakeCombatData: [%s] is not a static override effect, skipped."), *EffectClass->GetName());
+				break;
+			}
+			if (Row.ValidMask != 0)
+			{
+				AttributeDefaults.Add(Row);
+			}
+		}
+	}
+	AttributeDefaults.Sort([](const FAuraBakedAttributeDefaults& A, const FAuraBakedAttributeDefaults& B)
+	{
+		return A.EffectHash != B.EffectHash ? A.EffectHash < B.EffectHash : A.Level < B.Level;
+	});
+
+	// ヘッダー -> 各セクション（8バイト境界）の順に書く
+	TArray64<uint8> Blob;
+	Blob.SetNumZeroed(sizeof(FAuraCombatDataHeader));
+	Header.AttributeDefaultsOffset = AppendAligned(Blob, AttributeDefaults.GetData(), AttributeDefaults.Num() * sizeof(FAuraBakedAttributeDefaults));
+	Header.NumAttributeDefaults = AttributeDefaults.Num();
+	Header.FileSize = Blob.Num();
+	FMemory::Memcpy(Blob.GetData(), &Header, sizeof(Header));
+
+	if (!FFileHelper::SaveArrayToFile(Blob, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AuraBakeCombatData: failed to write [%s]."), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("AuraBakeCombatData: wrote %s (%lld bytes, %d attribute defaults from %d effects)."),
+		*OutputPath, Blob.Num(), AttributeDefaults.Num(), EffectClasses.Num());
+	return 0;
+}
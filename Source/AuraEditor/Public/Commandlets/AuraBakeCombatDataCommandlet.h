@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AuraBakeCombatDataCommandlet.generated.h"
+
+/**
+ * 初期値GE（静的なOverrideのみ）をレベルごとに評価した値をAuraCombatData.binに書き出す（クック前に実行）
+ * UnrealEditor-Cmd Aura.uproject -run=AuraBakeCombatData [-Effects=A+B] [-MaxLevel=40] [-Output=]
+ */
+UCLASS()
+class AURAEDITOR_API UAuraBakeCombatDataCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAuraBakeCombatDataCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class AuraServerTarget : TargetRules
+{
+	public AuraServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V4;
+
+		// Push model replication (UAuraAttributeSet, AAuraPlayerState) is compiled in by the engine's
+		// default for Server and Editor targets and enabled at runtime by net.IsPushModelEnabled.
+		// Forcing bWithPushModel needs a unique build environment, i.e. a source-built engine.
+
+		ExtraModuleNames.AddRange( new string[] { "Aura" } );
+	}
+}